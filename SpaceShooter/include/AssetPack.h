@@ -0,0 +1,93 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Single-file asset archive (little-endian):
+//   [Header][Entry x entryCount, sorted by name][padding][data, each entry aligned]
+// Entries are stored raw or LZ4-compressed and are read straight from an mmap.
+namespace AssetPackFormat {
+    const char MAGIC[4] = {'S', 'S', 'P', 'K'};
+    const std::uint32_t VERSION = 1;
+    const std::uint32_t DEFAULT_ALIGNMENT = 64;
+    const std::size_t MAX_NAME_LENGTH = 64;
+    const std::uint32_t FLAG_LZ4 = 1u << 0;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t entryCount;
+        std::uint32_t alignment;
+        std::uint64_t indexOffset;
+        std::uint64_t reserved;
+    };
+
+    struct Entry {
+        char name[MAX_NAME_LENGTH];     // Null-terminated lookup key
+        std::uint64_t offset;           // From start of file, multiple of alignment
+        std::uint64_t storedSize;
+        std::uint64_t rawSize;
+        std::uint32_t flags;
+        std::uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 32, "Pack header layout changed");
+    static_assert(sizeof(Entry) == 96, "Pack entry layout changed");
+}
+
+// Read-only view of a pack file mapped into memory
+class AssetPack {
+private:
+    const std::uint8_t* base;
+    std::size_t fileSize;
+    const AssetPackFormat::Entry* entries;
+    std::uint32_t entryCount;
+
+    void close();
+
+public:
+    AssetPack();
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const std::string& path);
+    bool isOpen() const;
+
+    const AssetPackFormat::Entry* find(const std::string& name) const;
+    bool isCompressed(const AssetPackFormat::Entry& entry) const;
+
+    // Pointer into the mapping (stored bytes, valid while the pack is open)
+    const std::uint8_t* data(const AssetPackFormat::Entry& entry) const;
+
+    // Decompresses (or copies) an entry into out
+    bool extract(const AssetPackFormat::Entry& entry, std::vector<std::uint8_t>& out) const;
+
+    std::uint32_t getEntryCount() const;
+};
+
+// Builds pack files (used by the assetpacker tool)
+class AssetPackWriter {
+private:
+    struct PendingEntry {
+        std::string name;
+        std::vector<std::uint8_t> data;
+        bool compress;
+    };
+
+    std::vector<PendingEntry> pending;
+    std::uint32_t alignment;
+
+public:
+    explicit AssetPackWriter(std::uint32_t alignment = AssetPackFormat::DEFAULT_ALIGNMENT);
+
+    bool add(const std::string& name, std::vector<std::uint8_t> data, bool compress);
+    bool addFile(const std::string& name, const std::string& filename, bool compress);
+    bool write(const std::string& path) const;
+};
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "SpscQueue.h"
+
+enum class SoundId : std::uint8_t {
+    PLAYER_SHOT,
+    ENEMY_SHOT,
+    EXPLOSION,
+    PLAYER_HIT,
+    COUNT
+};
+
+// Mixes a fixed pool of voices into interleaved 16-bit stereo. Sounds are
+// synthesized into mono buffers once, up front; a voice only holds a read
+// position into one. The game thread requests sounds through a lock-free
+// queue and the mixing thread (the device's, or the game thread itself when
+// mixing offline) assigns them to voices. When the pool, or a sound's own
+// instance limit, is full, the quietest lower-priority voice is faded out and
+// taken over, or the request is culled if everything playing matters more.
+class AudioMixer {
+public:
+    static const unsigned int SAMPLE_RATE = 44100;
+    static const unsigned int CHANNELS = 2;
+    static const std::size_t DEFAULT_VOICES = 24;
+
+    struct Stats {
+        std::uint64_t requests = 0;         // play() calls
+        std::uint64_t played = 0;           // Started on a free voice
+        std::uint64_t stolen = 0;           // Started by taking over a playing voice
+        std::uint64_t culled = 0;           // Inaudible, or everything playing mattered more
+        std::uint64_t dropped = 0;          // Request queue full (mixer not keeping up)
+        std::uint64_t mixedFrames = 0;
+        std::uint64_t mixNs = 0;            // Mixing thread time in mix()
+        std::uint64_t mixMaxNs = 0;         // Slowest mix() call
+        std::uint64_t mixCalls = 0;
+        int peakVoices = 0;
+    };
+
+    // voiceCount = 0 selects DEFAULT_VOICES
+    explicit AudioMixer(std::size_t voiceCount = 0);
+
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    // Synthesizes every sound (before a backend starts)
+    void createSounds();
+
+    // Per-sound instance limits (on by default); off, only the pool size bounds overlap
+    void setInstanceLimits(bool enabled);
+
+    // Field position that gain and panning are relative to (game thread)
+    void setListener(float x, float y);
+
+    // Requests a sound at a field position (game thread); never blocks
+    void play(SoundId sound, float x, float y);
+
+    // Starts queued requests, then mixes frames of interleaved stereo into out (mixing thread)
+    void mix(std::int16_t* out, std::size_t frames);
+
+    int getActiveVoices() const;
+    std::size_t getVoiceCount() const;
+
+    // Mixing thread counters are only final once the backend stopped
+    Stats getStats() const;
+    void report(std::ostream& out) const;
+
+private:
+    struct Request {
+        SoundId sound;
+        float gain;
+        float pan;              // -1 left .. 1 right
+    };
+
+    struct Voice {
+        const std::int16_t* samples;
+        std::uint32_t length;
+        std::uint32_t position;
+        float gainLeft;
+        float gainRight;
+        float importance;       // Priority x gain when started
+        std::uint32_t fade;     // Frames of fade-out left after being stolen, 0 = not fading
+        SoundId sound;
+        bool active;
+        bool hasNext;           // Request to start once the fade-out ends
+        Request next;
+    };
+
+    std::vector<std::int16_t> sounds[static_cast<int>(SoundId::COUNT)];
+    std::vector<Voice> voices;
+    std::vector<float> scratch;             // Float accumulation for one block
+    SpscQueue<Request, 256> requests;       // Game thread -> mixing thread
+    float listenerX;
+    float listenerY;
+    bool instanceLimits;
+
+    // Game thread counters
+    std::uint64_t requestCount;
+    std::uint64_t droppedCount;
+    std::uint64_t inaudibleCount;
+
+    // Mixing thread counters
+    Stats stats;
+    std::atomic<int> activeVoices;
+
+    void start(const Request& request);
+    void assign(Voice& voice, const Request& request);
+    void mixBlock(std::int16_t* out, std::size_t frames);
+    float currentImportance(const Voice& voice) const;
+};
+
+// Where mixed audio goes
+class AudioBackend {
+public:
+    virtual ~AudioBackend() {}
+
+    virtual bool start(AudioMixer& mixer) = 0;
+    virtual void stop() = 0;
+
+    // Once per game frame with the frame's elapsed time (offline backends mix here)
+    virtual void update(float dt) { (void)dt; }
+
+    virtual const char* getName() const = 0;
+};
+
+// No device: mixes the elapsed time on the game thread and throws the result
+// away, so voice scheduling and mixing cost the same as with a device
+class NullAudioBackend : public AudioBackend {
+private:
+    AudioMixer* mixer;
+    std::vector<std::int16_t> buffer;
+    double pendingFrames;
+
+public:
+    NullAudioBackend();
+
+    bool start(AudioMixer& mixer) override;
+    void stop() override;
+    void update(float dt) override;
+    const char* getName() const override;
+};
+
+// Sound device through SFML's streaming thread, which pulls mixed blocks
+class DeviceAudioBackend : public AudioBackend, private sf::SoundStream {
+private:
+    AudioMixer* mixer;
+    std::vector<std::int16_t> buffer;
+
+    bool onGetData(Chunk& data) override;
+    void onSeek(sf::Time timeOffset) override;
+
+public:
+    DeviceAudioBackend();
+    ~DeviceAudioBackend() override;
+
+    bool start(AudioMixer& mixer) override;
+    void stop() override;
+    const char* getName() const override;
+};
+
+enum class AudioOutput {
+    DEVICE,     // Sound card through sfml-audio
+    OFFLINE,    // Mixed on the game thread and discarded (NullAudioBackend)
+    OFF         // No sound at all
+};
+
+// nullptr for OFF
+std::unique_ptr<AudioBackend> createAudioBackend(AudioOutput output);
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef AUTOPILOT_INPUT_H
+#define AUTOPILOT_INPUT_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "InputSource.h"
+
+// Bot player: scores the nine possible moves against threats near the player
+// (found with the simulation's spatial queries, never a full enemy scan), lines up
+// under the closest enemy above and fires when one is in the firing column.
+class AutopilotInput : public InputSource {
+public:
+    struct DecisionStats {
+        std::uint64_t decisions = 0;
+        std::uint64_t totalNs = 0;
+        std::uint64_t maxNs = 0;
+        std::uint64_t threatsVisited = 0;   // Spatial query candidates examined
+
+        void merge(const DecisionStats& other);
+        double meanUs() const;
+    };
+
+private:
+    struct Threat {
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        float radius;
+    };
+
+    std::vector<Threat> threats;            // Scratch, reused every decision
+    int lastMove;
+    DecisionStats stats;
+
+    PlayerInput decide(const Simulation& simulation);
+
+public:
+    AutopilotInput();
+
+    PlayerInput nextInput(const Simulation& simulation) override;
+
+    const DecisionStats& getStats() const;
+    void resetStats();
+};
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include "TimingWheel.h"
+#include "RenderBackend.h"
 
 class Star {
 private:
@@ -12,21 +14,34 @@ private:
 public:
     Star(float x, float y, float speed, const sf::Texture& texture);
     void update(float dt);
-    void render(sf::RenderWindow& window);
+    void render(RenderBackend& backend);
 };
 
 class Background {
 private:
     std::vector<Star> stars;
-    float spawnTimer;
     float spawnInterval;
+    std::size_t starLimit;
+    TimingWheel* timers;
+    TimingWheel::TimerId spawnTimer;
+    std::uint64_t spawnTicks;
+    
+    // Spawn timer callback: adds a star (below the limit) and schedules the next
+    void spawnStar();
 
 public:
     Background();
     
+    // Starts spawning stars every spawnInterval on timers, which advance once
+    // per tickLength seconds
+    void attach(TimingWheel& timers, float tickLength);
+    
     void update(float dt);
-    void render(sf::RenderWindow& window);
+    void render(RenderBackend& backend);
     void clear();
+    
+    // Caps the star count, dropping extra stars right away (frame governor)
+    void setStarLimit(std::size_t limit);
 };
 
 #endif
@@ -0,0 +1,40 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+// Headless benchmark scenes, selected from the command line (see main.cpp).
+// Each prints its results to stdout and returns a process exit code.
+
+// Spiral emitters keep projectileCount enemy projectiles alive against a player target
+int runProjectileBenchmark(int projectileCount, int ticks);
+
+// Batched path movement (mixed and straight-line) against per-enemy virtual updates
+int runMovementBenchmark(int moverCount, int ticks);
+
+// Raycast, radius and nearest queries on a SpatialIndex of moving entities against linear scans
+int runSpatialBenchmark(int entityCount, int ticks);
+
+// Word-parallel collision mask tests on box-overlapping sprite pairs, checked against a per-pixel test
+int runMaskBenchmark(int pairCount);
+
+// Bullet vs enemy hit detection, serial against bullet ranges on worker threads with merged queues
+int runCollisionBenchmark(int entityCount, int passes);
+
+// Repeating cooldown timers on a TimingWheel against per-tick polled countdowns
+int runTimerBenchmark(int timerCount, int ticks);
+
+// Streams a generated level of the given length tick by tick, against loading it up front
+int runLevelBenchmark(int minutes);
+
+// Dense combat sound triggers mixed offline through the voice pool, against a voice per trigger
+int runAudioBenchmark(int triggersPerSecond);
+
+// Scripted sessions on the float simulation against the fixed-point one, with state hashes to compare builds
+int runFixedPointBenchmark(int sessions);
+
+// A world-like sprite scene rasterized by the SoftwareRenderer: scalar, SIMD, and SIMD on worker threads
+int runRenderBenchmark(int spriteCount, int frames);
+
+// Scripted sessions with and without metrics publishing, and while the endpoint is scraped over loopback
+int runMetricsBenchmark(int sessions);
+
+#endif
@@ -5,9 +5,13 @@
 
 class Bullet : public Entity {
 public:
-    Bullet(float x, float y);
+    Bullet(float x, float y, const sf::Texture* texture);
     
     void update(float dt) override;
+    
+    // Fixed-point start and one tick of update() (deterministic mode)
+    void initFixed(const FixedVec2& pos, int ticksPerSecond);
+    void updateFixed();
 };
 
 #endif
@@ -0,0 +1,48 @@
+#ifndef COLLISION_MASK_H
+#define COLLISION_MASK_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Broad-phase pairs versus pairs confirmed by the mask test
+struct CollisionStats {
+    std::uint64_t boxOverlaps = 0;      // Pairs passing the AABB test
+    std::uint64_t maskTests = 0;
+    std::uint64_t maskRejects = 0;      // Box overlaps with no shared opaque pixel
+
+    void merge(const CollisionStats& other);
+};
+
+// 1-bit opacity mask for pixel-accurate collision. Each row is packed into
+// 64-bit words (bit i of word k is pixel x = 64k + i), so an overlap test
+// costs one AND per 64 pixels of row overlap.
+class CollisionMask {
+private:
+    int width;
+    int height;
+    int wordsPerRow;
+    std::vector<std::uint64_t> bits;
+
+public:
+    CollisionMask();
+    CollisionMask(int width, int height);
+
+    // Pixels with alpha >= threshold are solid
+    static CollisionMask fromImage(const sf::Image& image, std::uint8_t alphaThreshold = 128);
+    static CollisionMask filled(int width, int height);
+
+    int getWidth() const;
+    int getHeight() const;
+    bool isSolid(int x, int y) const;
+    void setSolid(int x, int y, bool solid);
+    std::size_t countSolid() const;
+
+    // Do a (top-left at ax, ay) and b (top-left at bx, by) share a solid pixel?
+    static bool overlaps(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by);
+
+    // Any solid pixel inside the rectangle (in mask coordinates)?
+    bool overlapsRect(int x, int y, int w, int h) const;
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+
+// LZ4 block format (no frame header): fast to decode, used for packed assets
+
+// Worst-case compressed size for an input of srcSize bytes
+std::size_t lz4CompressBound(std::size_t srcSize);
+
+// Returns the compressed size, or 0 if dst is too small
+std::size_t lz4Compress(const std::uint8_t* src, std::size_t srcSize,
+                        std::uint8_t* dst, std::size_t dstCapacity);
+
+// Decodes exactly dstSize bytes; returns false on malformed input
+bool lz4Decompress(const std::uint8_t* src, std::size_t srcSize,
+                   std::uint8_t* dst, std::size_t dstSize);
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef DYNAMIC_AABB_TREE_H
+#define DYNAMIC_AABB_TREE_H
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <vector>
+
+struct Aabb {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+
+    static Aabb fromRect(const sf::FloatRect& rect);
+    static Aabb combine(const Aabb& a, const Aabb& b);
+
+    bool overlaps(const Aabb& other) const;
+    bool contains(const Aabb& other) const;
+    float perimeter() const;
+
+    // Squared distance from a point to the box (0 inside)
+    float distanceSquared(float x, float y) const;
+};
+
+// Bounding volume hierarchy over moving boxes. Leaves store "fat" boxes grown
+// by a margin, so most moves don't touch the tree; a leaf is only reinserted
+// when its box leaves the fat box. Kept height-balanced with AVL rotations.
+// Proxy ids are node indices and stay valid until destroyProxy.
+class DynamicAabbTree {
+private:
+    struct Node {
+        Aabb box;
+        int parent;         // Next free node while on the free list
+        int child1;
+        int child2;
+        int height;         // 0 for leaves, -1 for free nodes
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    // Traversal stack size; balanced trees of millions of leaves stay far below it
+    static const int STACK_SIZE = 256;
+
+    std::vector<Node> nodes;
+    int root;
+    int freeList;
+    int proxyCount;
+    float margin;
+
+    int allocateNode();
+    void freeNode(int node);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int node);
+
+    // Narrows [enter, exit] to where the segment is between lo and hi on one axis
+    static bool clipSlab(float origin, float delta, float inv, float lo, float hi, float& enter, float& exit) {
+        if (delta == 0.f) {
+            return origin >= lo && origin <= hi;
+        }
+        float t1 = (lo - origin) * inv;
+        float t2 = (hi - origin) * inv;
+        enter = std::max(enter, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+        return enter <= exit;
+    }
+
+public:
+    static const int NULL_NODE = -1;
+
+    explicit DynamicAabbTree(float margin = 8.f);
+
+    int createProxy(const Aabb& box);
+    void destroyProxy(int proxy);
+
+    // Returns true if the leaf was reinserted. The fat box is stretched along the
+    // displacement so steadily moving proxies are reinserted less often.
+    bool moveProxy(int proxy, const Aabb& box, float dx, float dy);
+
+    void clear();
+
+    // Preallocate nodes for this many proxies
+    void reserve(int proxies);
+
+    const Aabb& getFatBox(int proxy) const;
+    int getHeight() const;
+    int getProxyCount() const;
+
+    // Calls visit(proxy) for every leaf whose fat box overlaps box
+    template <typename Visitor>
+    void query(const Aabb& box, Visitor&& visit) const {
+        int stack[STACK_SIZE];
+        int top = 0;
+        if (root != NULL_NODE) stack[top++] = root;
+
+        while (top > 0) {
+            int index = stack[--top];
+            const Node& node = nodes[index];
+            if (!node.box.overlaps(box)) continue;
+
+            if (node.isLeaf()) {
+                visit(index);
+            } else {
+                stack[top++] = node.child1;
+                stack[top++] = node.child2;
+            }
+        }
+    }
+
+    // Segment cast from (x1, y1) to (x2, y2). visit(proxy, maxFraction) is called for
+    // leaves whose fat box the remaining segment crosses and returns the new maximum
+    // fraction: 0 stops, the value it was given continues, anything smaller clips the ray.
+    template <typename Visitor>
+    void raycast(float x1, float y1, float x2, float y2, Visitor&& visit) const {
+        float dx = x2 - x1;
+        float dy = y2 - y1;
+        float invX = dx != 0.f ? 1.f / dx : 0.f;
+        float invY = dy != 0.f ? 1.f / dy : 0.f;
+        float maxFraction = 1.f;
+
+        int stack[STACK_SIZE];
+        int top = 0;
+        if (root != NULL_NODE) stack[top++] = root;
+
+        while (top > 0) {
+            int index = stack[--top];
+            const Node& node = nodes[index];
+
+            // Slab test against [0, maxFraction]
+            float enter = 0.f;
+            float exit = maxFraction;
+            if (!clipSlab(x1, dx, invX, node.box.minX, node.box.maxX, enter, exit) ||
+                !clipSlab(y1, dy, invY, node.box.minY, node.box.maxY, enter, exit)) {
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                float value = visit(index, maxFraction);
+                if (value <= 0.f) return;
+                maxFraction = std::min(maxFraction, value);
+            } else {
+                stack[top++] = node.child1;
+                stack[top++] = node.child2;
+            }
+        }
+    }
+
+    // Branch-and-bound nearest search. distance(proxy) returns the squared distance
+    // of a leaf's object (or a negative value to skip it); subtrees whose fat box is
+    // farther than the best so far are pruned. Returns NULL_NODE if nothing is within
+    // maxDistance.
+    template <typename Distance>
+    int nearest(float x, float y, float maxDistance, Distance&& distance) const {
+        int best = NULL_NODE;
+        float bestSquared = maxDistance * maxDistance;
+
+        int stack[STACK_SIZE];
+        int top = 0;
+        if (root != NULL_NODE) stack[top++] = root;
+
+        while (top > 0) {
+            int index = stack[--top];
+            const Node& node = nodes[index];
+            if (node.box.distanceSquared(x, y) >= bestSquared) continue;
+
+            if (node.isLeaf()) {
+                float d = distance(index);
+                if (d >= 0.f && d < bestSquared) {
+                    bestSquared = d;
+                    best = index;
+                }
+            } else {
+                // Push the farther child first so the nearer one is explored first
+                float d1 = nodes[node.child1].box.distanceSquared(x, y);
+                float d2 = nodes[node.child2].box.distanceSquared(x, y);
+                if (d1 < d2) {
+                    stack[top++] = node.child2;
+                    stack[top++] = node.child1;
+                } else {
+                    stack[top++] = node.child1;
+                    stack[top++] = node.child2;
+                }
+            }
+        }
+        return best;
+    }
+};
+
+#endif
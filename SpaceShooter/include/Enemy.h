@@ -2,16 +2,38 @@
 #define ENEMY_H
 
 #include "Entity.h"
+#include <optional>
+#include "Projectile.h"
+#include "MovementSystem.h"
 
 class Enemy : public Entity {
 private:
     int scoreValue;
+    MoverHandle mover;                          // Position comes from the MovementSystem
+    int proxy;                                  // Entry in the simulation's SpatialIndex
+    std::optional<BulletEmitter> emitter;      // Empty for enemies that don't shoot
 
 public:
-    Enemy(float x, float y, float speedMultiplier = 1.f);
+    Enemy(float x, float y, MoverHandle mover, const sf::Texture* texture);
+    
+    // Bring a pooled enemy back as a fresh, unarmed one
+    void respawn(float x, float y, MoverHandle mover);
     
     void update(float dt) override;
+    
+    // Takes the mover's fixed-point position and culls like update() (deterministic mode)
+    void updateFixed(const FixedVec2& pos);
+    
     int getScoreValue() const;
+    MoverHandle getMover() const;
+    int getProxy() const;
+    void setProxy(int proxy);
+    
+    // Give this enemy a firing pattern
+    void arm(const BulletPattern& pattern, float initialDelay);
+    // Returns true if it fired
+    bool updateWeapon(float dt, const sf::Vector2f& target, ProjectileSystem& projectiles);
+    bool updateWeaponFixed(const FixedVec2& target, int ticksPerSecond, ProjectileSystem& projectiles);
 };
 
 #endif
@@ -0,0 +1,69 @@
+#ifndef ENGINE_METRICS_H
+#define ENGINE_METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Metrics.h"
+#include "CollisionMask.h"
+#include "GameEvents.h"
+
+class Simulation;
+
+// Enemies destroyed and damage taken, tallied from step events
+struct EventTally {
+    std::uint64_t enemiesDestroyed = 0;
+    std::uint64_t playerDamage = 0;
+
+    void add(const GameEventQueue& events);
+};
+
+// The game's metrics (--metrics), registered once and updated from the frame
+// loop, the simulation tick and batch workers. Every update is a handful of
+// relaxed atomic operations; scrapes are served from MetricsServer's thread.
+struct EngineMetrics {
+    MetricsRegistry registry;
+
+    MetricCounter& frames;
+    MetricHistogram& frameSeconds;
+    MetricCounter& ticks;
+    MetricCounter& sessions;
+    MetricHistogram& sessionScore;
+
+    MetricGauge& enemies;
+    MetricGauge& bullets;
+    MetricGauge& projectiles;
+    MetricGauge& particles;
+
+    MetricCounter& enemiesSpawned;
+    MetricCounter& enemiesDestroyed;
+    MetricCounter& playerDamage;
+    MetricCounter& collisionPairs;
+    MetricCounter& maskTests;
+    MetricCounter& maskRejects;
+
+    MetricGauge& score;
+    MetricGauge& difficulty;
+    MetricGauge& health;
+
+    EngineMetrics();
+
+    // Live session (the game): counts tick by tick. Spawn and collision
+    // totals are published as the growth since startSession().
+    void startSession();
+    void recordTick(const Simulation& simulation);
+    void recordFrame(float seconds, const Simulation* simulation, std::size_t liveParticles);
+    void endSession(int finalScore);
+
+    // Finished batch session, added in one go with the events tallied over
+    // its steps (safe from any thread)
+    void recordSession(const Simulation& simulation, const EventTally& events);
+
+private:
+    std::uint64_t publishedSpawns;
+    CollisionStats publishedCollisions;
+
+    void addEvents(const EventTally& events);
+    void addCollisions(const CollisionStats& stats);
+};
+
+#endif
@@ -3,6 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 #include <memory>
+#include "Fixed.h"
+#include "RenderBackend.h"
 
 // Base class for all game objects (Player, Enemy, Bullet, etc.)
 class Entity {
@@ -11,6 +13,15 @@ protected:
     sf::Vector2f velocity;
     bool active;
     float speed;
+    sf::Vector2f hitboxSize;    // Centered on the position, independent of the texture
+    
+    // Deterministic mode: authoritative fixed-point state, mirrored into the sprite
+    FixedVec2 fixedPosition;
+    FixedVec2 fixedVelocity;    // Per tick
+    FixedVec2 fixedHitboxSize;
+    
+    // Optional texture (null when running headless) plus the collision size
+    void initSprite(const sf::Texture* texture, float width, float height);
 
 public:
     Entity();
@@ -18,7 +29,7 @@ public:
 
     // Pure virtual functions - must be implemented by derived classes
     virtual void update(float dt) = 0;
-    virtual void render(sf::RenderWindow& window);
+    virtual void render(RenderBackend& backend);
 
     // Getters and setters
     sf::Vector2f getPosition() const;
@@ -26,6 +37,12 @@ public:
     void setPosition(const sf::Vector2f& pos);
     
     sf::FloatRect getBounds() const;
+    
+    // Fixed-point position and hitbox (deterministic mode only)
+    void setFixedPosition(const FixedVec2& pos);
+    const FixedVec2& getFixedPosition() const;
+    FixedRect getFixedBounds() const;
+    
     bool isActive() const;
     void setActive(bool active);
     
@@ -0,0 +1,99 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <cmath>
+#include <cstdint>
+
+// Q16.16 fixed-point number for the deterministic simulation mode. All
+// arithmetic is on integers, so results are the same bit for bit whatever the
+// compiler, optimization level or floating-point flags. Floats only come in
+// to build constants from configuration values and go out for rendering.
+class Fixed {
+private:
+    std::int32_t raw;
+
+public:
+    static const int FRACTION_BITS = 16;
+    static const std::int32_t ONE = 1 << FRACTION_BITS;
+
+    constexpr Fixed() : raw(0) {}
+
+    static constexpr Fixed fromRaw(std::int32_t value) {
+        Fixed f;
+        f.raw = value;
+        return f;
+    }
+    static constexpr Fixed fromInt(int value) { return fromRaw(value * ONE); }
+
+    // Nearest representable value (scaling by a power of two is exact, lround is well defined)
+    static Fixed fromFloat(float value) { return fromRaw(static_cast<std::int32_t>(std::lround(value * ONE))); }
+
+    float toFloat() const { return static_cast<float>(raw) / ONE; }
+    std::int32_t getRaw() const { return raw; }
+
+    // Integer part rounded down and to nearest (arithmetic shifts floor)
+    int floor() const { return raw >> FRACTION_BITS; }
+    int round() const { return (raw + ONE / 2) >> FRACTION_BITS; }
+
+    Fixed operator+(Fixed other) const { return fromRaw(raw + other.raw); }
+    Fixed operator-(Fixed other) const { return fromRaw(raw - other.raw); }
+    Fixed operator-() const { return fromRaw(-raw); }
+    Fixed operator*(Fixed other) const {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(raw) * other.raw) >> FRACTION_BITS));
+    }
+    Fixed operator/(Fixed other) const {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(raw) * ONE) / other.raw));
+    }
+    Fixed operator*(int n) const { return fromRaw(raw * n); }
+    Fixed operator/(int n) const { return fromRaw(raw / n); }
+
+    Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+    Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+
+    bool operator==(Fixed other) const { return raw == other.raw; }
+    bool operator!=(Fixed other) const { return raw != other.raw; }
+    bool operator<(Fixed other) const { return raw < other.raw; }
+    bool operator<=(Fixed other) const { return raw <= other.raw; }
+    bool operator>(Fixed other) const { return raw > other.raw; }
+    bool operator>=(Fixed other) const { return raw >= other.raw; }
+
+    Fixed abs() const { return raw < 0 ? fromRaw(-raw) : *this; }
+    static Fixed min(Fixed a, Fixed b) { return a < b ? a : b; }
+    static Fixed max(Fixed a, Fixed b) { return a < b ? b : a; }
+
+    // Bitwise integer square root (negative values give 0)
+    static Fixed sqrt(Fixed value);
+
+    // sin and cos of an angle in turns (1 = 360 degrees), max error ~0.001
+    static Fixed sinTurns(Fixed turns);
+    static Fixed cosTurns(Fixed turns);
+
+    // Direction of (x, y) in turns, (-0.5, 0.5], max error ~0.0003 turns
+    static Fixed atan2Turns(Fixed y, Fixed x);
+};
+
+struct FixedVec2 {
+    Fixed x;
+    Fixed y;
+
+    FixedVec2() {}
+    FixedVec2(Fixed x, Fixed y) : x(x), y(y) {}
+};
+
+struct FixedRect {
+    Fixed left;
+    Fixed top;
+    Fixed width;
+    Fixed height;
+
+    // Same edge rules as sf::Rect (touching edges don't intersect)
+    bool intersects(const FixedRect& other) const {
+        return left < other.left + other.width && other.left < left + width
+            && top < other.top + other.height && other.top < top + height;
+    }
+    bool contains(Fixed x, Fixed y) const {
+        return x >= left && x < left + width && y >= top && y < top + height;
+    }
+};
+
+#endif
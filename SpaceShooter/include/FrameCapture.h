@@ -0,0 +1,109 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+
+enum class CaptureFormat {
+    RAW,    // frame_000001.rgba, ... (top-down RGBA, no header)
+    PNG,    // frame_000001.png, ...
+    PIPE    // Raw RGBA frames on the stdin of an encoder command
+};
+
+// Records rendered frames without stalling the game loop. Each frame is read
+// back from the offscreen target into a ring of pixel buffer objects: the copy
+// runs on the GPU and the buffer is only mapped frames later, once its fence
+// has signalled. Mapped frames are copied into a pool of CPU buffers that an
+// encoder thread writes out. When the GPU or the encoder falls behind, frames
+// are dropped and counted instead of waited for.
+class FrameCapture {
+public:
+    static const int READBACK_SLOTS = 3;    // Readbacks in flight on the GPU
+    static const int FRAME_BUFFERS = 8;     // Frames queued for (or being written by) the encoder
+
+    struct Stats {
+        std::uint64_t readBack = 0;         // Frames copied out of the GPU
+        std::uint64_t written = 0;          // Frames the encoder wrote
+        std::uint64_t droppedGpu = 0;       // All readback slots still busy
+        std::uint64_t droppedEncoder = 0;   // No free frame buffer (encoder behind)
+        std::uint64_t writeErrors = 0;
+        std::uint64_t captureNs = 0;        // Game thread time spent in capture()
+        std::uint64_t captureMaxNs = 0;
+        std::uint64_t encodeNs = 0;         // Encoder thread time spent writing
+        std::uint64_t frames = 0;           // capture() calls
+    };
+
+    FrameCapture();
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    // Records target's frames. destination is a directory for RAW and PNG
+    // (created if missing) and a shell command for PIPE. Returns false (and
+    // logs why) if capture can't start.
+    bool start(sf::RenderTexture& target, CaptureFormat format, const std::string& destination);
+
+    // Collects the readbacks still in flight, lets the encoder finish and closes the output
+    void stop();
+    bool isRunning() const;
+
+    // Queues a readback of the target's current contents (call after its
+    // display()); doesn't wait for the GPU or the encoder
+    void capture();
+
+    // Encoder counters are only final after stop()
+    const Stats& getStats() const;
+    void report(std::ostream& out) const;
+
+private:
+    struct Slot {
+        unsigned int buffer;    // Pixel pack buffer
+        void* fence;            // Signalled when the readback into buffer completed
+        std::uint64_t frame;    // Frame number it was issued on
+        bool pending;
+    };
+
+    CaptureFormat format;
+    std::string destination;
+    unsigned int width;
+    unsigned int height;
+    std::size_t frameBytes;
+    bool running;
+    bool asyncReadback;         // Pixel buffer objects available
+    bool useFences;             // Otherwise a slot is mapped READBACK_SLOTS - 1 frames after it was issued
+    sf::RenderTexture* source;  // Its context owns the pixel buffers
+
+    Slot slots[READBACK_SLOTS];
+    int nextSlot;               // Oldest slot, and the next one to issue into
+    std::uint64_t frameCounter;
+
+    // Frame buffers are handed to the encoder and back by index
+    std::vector<std::uint8_t> frames[FRAME_BUFFERS];
+    SpscQueue<int, 16> filledFrames;    // Game thread -> encoder
+    SpscQueue<int, 16> freeFrames;      // Encoder -> game thread
+    std::FILE* pipe;
+    std::thread encoder;
+    std::atomic<bool> encoding;
+
+    Stats stats;
+
+    bool createBuffers();
+    void destroyBuffers();
+    void issue(Slot& slot);
+    bool isComplete(const Slot& slot, bool wait) const;
+    void collect(bool wait);
+    void transfer(Slot& slot, bool wait);
+
+    void encoderLoop();
+    void writeFrame(int index);
+};
+
+#endif
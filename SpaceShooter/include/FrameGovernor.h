@@ -0,0 +1,48 @@
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#include <cstddef>
+
+// Measures frame time against a budget and steps effect quality down when
+// frames run long, back up when there is sustained headroom
+class FrameGovernor {
+public:
+    struct Telemetry {
+        float frameTimeMs;      // Smoothed full frame time (including limiter/vsync wait)
+        float workTimeMs;       // Smoothed update + render submission time
+        float budgetMs;
+        int level;              // 0 = full quality
+        float particleScale;
+        std::size_t starLimit;
+        float renderScale;
+        unsigned int downgrades;
+        unsigned int upgrades;
+    };
+
+private:
+    float budget;
+    float smoothedFrameTime;
+    float smoothedWorkTime;
+    int level;
+    int overBudgetFrames;
+    int headroomFrames;
+    Telemetry telemetry;
+
+    void applyLevel();
+
+public:
+    explicit FrameGovernor(float targetFps = 60.f);
+
+    // Feed one finished frame; returns true if the quality level changed
+    bool recordFrame(float frameTime, float workTime);
+    void reset();
+
+    float getParticleScale() const;
+    std::size_t getStarLimit() const;
+    float getRenderScale() const;
+    int getLevel() const;
+
+    const Telemetry& getTelemetry() const;
+};
+
+#endif
@@ -3,12 +3,45 @@
 
 #include <SFML/Graphics.hpp>
 #include <memory>
+#include <string>
 #include <vector>
-#include "Player.h"
-#include "Enemy.h"
-#include "Bullet.h"
+#include "Simulation.h"
 #include "Particle.h"
 #include "Background.h"
+#include "ResourceManager.h"
+#include "FrameGovernor.h"
+#include "InputSampler.h"
+#include "LatencyMeter.h"
+#include "AutopilotInput.h"
+#include "Profiler.h"
+#include "Playfield.h"
+#include "FrameCapture.h"
+#include "Audio.h"
+#include "RenderBackend.h"
+#include "SoftwareRenderer.h"
+#include "EngineMetrics.h"
+
+// Command-line configurable settings
+struct GameOptions {
+    bool measureLatency = false;    // Report input-to-display latency
+    bool legacyInput = false;       // Sample input once per frame instead of on the sampler thread
+    bool autopilot = false;         // Bot plays instead of the keyboard
+    bool trackAllocations = false;  // Per-frame heap allocations by profiler zone
+    int allocationBudget = -1;      // >= 0: play on autopilot and fail if a steady-state frame allocates more
+    unsigned int windowWidth = 800;
+    unsigned int windowHeight = 600;
+    float renderScale = 1.f;        // Internal resolution relative to the window area the field covers
+    std::string capturePath;        // Non-empty: record frames (directory, or encoder command for PIPE)
+    CaptureFormat captureFormat = CaptureFormat::PNG;
+    std::string levelPath;          // Authored level file; empty = endless random spawns
+    bool idleRendering = true;      // Menu and game over wait for input instead of rendering every frame
+    bool reportCpu = false;         // Process CPU usage in menus and gameplay, printed on exit
+    bool logGovernor = false;       // Print every quality level change
+    AudioOutput audioOutput = AudioOutput::DEVICE;
+    bool fixedPoint = false;        // Deterministic fixed-point simulation
+    bool softwareRender = false;    // Rasterize the world on the CPU (SoftwareRenderer)
+    std::string metricsAddress;     // Non-empty: serve metrics on this port or socket path
+};
 
 enum class GameState {
     MENU,
@@ -18,21 +51,18 @@ enum class GameState {
 
 class Game {
 private:
+    GameOptions options;
     sf::RenderWindow window;
     GameState state;
     
-    // Game objects
-    std::unique_ptr<Player> player;
-    std::vector<std::unique_ptr<Enemy>> enemies;
-    std::vector<std::unique_ptr<Bullet>> bullets;
+    // Gameplay lives in the simulation; Game adds window, input and effects around it
+    SimulationConfig simConfig;
+    std::unique_ptr<Simulation> simulation;
     ParticleSystem particleSystem;
     Background background;
-    
-    // Game stats
-    int score;
-    float difficultyLevel;
-    float enemySpawnTimer;
-    float enemySpawnInterval;
+    TimingWheel effectTimers;           // Advanced once per simulation tick
+    AudioMixer audio;
+    std::unique_ptr<AudioBackend> audioBackend;     // Null when audio is off
     
     // UI elements
     sf::Text scoreText;
@@ -44,34 +74,122 @@ private:
     sf::Text gameOverText;
     sf::Text finalScoreText;
     sf::Text restartText;
+    int hudScore;                       // Values the HUD texts currently show
+    int hudHealth;
+    int hudDifficultyTenths;
+    sf::String hudString;               // Scratch for HUD text updates (keeps its capacity)
+    sf::RectangleShape loadingBarBack;
+    sf::RectangleShape loadingBarFill;
+    
+    // Async font load; UI texts are set up once it is uploaded
+    AssetHandle fontHandle;
+    bool uiReady;
     
     // Delta time
     sf::Clock clock;
     
+    // The play field is letterboxed into the window; the world is drawn into
+    // sceneTarget when the render scale (option times governor) isn't 1
+    sf::View fieldView;
+    sf::RectangleShape fieldBackground;
+    FrameGovernor governor;
+    float lastWorkTime;
+    float sceneScale;
+    sf::RenderTexture sceneTarget;
+    sf::Sprite sceneSprite;
+    sf::Text telemetryText;
+    bool showTelemetry;
+    
+    // The world is drawn through worldBackend, or with --software-render
+    // rasterized on the CPU and uploaded as one texture per frame
+    SfmlRenderBackend worldBackend;
+    std::unique_ptr<SoftwareRenderer> softwareRenderer;
+    sf::Texture softwareTexture;
+    sf::Sprite softwareSprite;
+    
+    // Frame capture (--capture): whole frames are drawn into captureTarget at
+    // field resolution, read back asynchronously and shown through captureSprite
+    sf::RenderTexture captureTarget;
+    sf::Sprite captureSprite;
+    FrameCapture frameCapture;
+    
+    // --metrics: counters and gauges for scrapes, null when off
+    std::unique_ptr<EngineMetrics> metrics;
+    std::unique_ptr<MetricsServer> metricsServer;
+    
+    // Fixed-step simulation fed by the input sampler
+    InputSampler inputSampler;
+    PlayerInput playerInput;
+    bool fireTapped;                    // Fire pressed during the tick (even if already released)
+    float tickAccumulator;
+    std::int64_t simTimeUs;             // Sampler-clock time at the end of the last tick
+    AutopilotInput autopilot;           // Used instead of playerInput with --autopilot
+    
+    // Input latency measurement (--latency)
+    LatencyMeter latencyMeter;
+    std::vector<std::int64_t> frameInputTimes;
+    sf::Clock latencyReportClock;
+    
+    // Allocation test (--alloc-test): frames counted since the session (re)started
+    int steadyFrames;
+    int measuredFrames;
+    int framesOverBudget;
+    Profiler::Frame worstFrame;
+    
     // Menu selection
     int menuSelection;
     
+    // Idle menus: frames are only drawn when something on screen changed
+    bool redraw;
+    
+    // --cpu-report: wall and process CPU time per kind of frame
+    struct CpuUsage {
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        int frames = 0;
+    };
+    CpuUsage menuUsage;
+    CpuUsage playUsage;
+    sf::Clock usageClock;
+    double lastCpuSeconds;
+    
 public:
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
     
-    void run();
+    // Returns the process exit code (non-zero when the allocation test fails)
+    int run();
     
 private:
     void processEvents();
+    void handleEvent(const sf::Event& event);
     void update(float dt);
     void render();
     
+    void setupUI();
+    void updateGovernor(float frameTime);
+    void applyQuality();
+    void applyRenderScale(float scale);
+    void resizeView();
+    void renderLoading(sf::RenderTarget& frame);
+    
     void updateMenu();
+    void advanceSimulation(float dt);
+    void applyInputEvents(std::int64_t tickEndUs);
     void updatePlaying(float dt);
+    void spawnEffects(const GameEventQueue& events);
+    void playSounds(const GameEventQueue& events);
+    void updateHud();
+    void recordLatency();
+    bool isIdle() const;
+    void waitForInput();
+    bool waitForEvent(sf::Event& event, sf::Time timeout);
+    void accountCpu(bool menu, bool rendered);
+    void checkAllocations(const Profiler::Frame& frame);
     void updateGameOver();
     
-    void renderMenu();
-    void renderPlaying();
-    void renderGameOver();
-    
-    void spawnEnemy();
-    void checkCollisions();
-    void cleanupEntities();
+    void renderMenu(sf::RenderTarget& frame);
+    void renderPlaying(sf::RenderTarget& frame);
+    void renderGameOver(sf::RenderTarget& frame);
     
     void startGame();
     void gameOver();
@@ -0,0 +1,69 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Contact found by collision detection. Detection only reads entity state and
+// records hits; they are applied afterwards, in queue order, by the resolve phase.
+enum class HitType : std::uint8_t {
+    BULLET_ENEMY,       // first = bullet index, second = enemy index
+    ENEMY_PLAYER,       // first = enemy index
+    PROJECTILE_PLAYER   // first = enemy projectile index
+};
+
+struct HitEvent {
+    HitType type;
+    std::uint32_t first;
+    std::uint32_t second;
+
+    bool operator==(const HitEvent& other) const {
+        return type == other.type && first == other.first && second == other.second;
+    }
+};
+
+// Outcome of a simulation step, for effects (particles, sound) and telemetry
+enum class GameEventType : std::uint8_t {
+    ENEMY_DESTROYED,    // value = score awarded
+    PLAYER_RAMMED,      // value = damage taken
+    PLAYER_SHOT,        // value = damage taken (all projectiles of the tick)
+    PLAYER_FIRED,       // value = 0
+    ENEMY_FIRED         // value = 0
+};
+
+struct GameEvent {
+    GameEventType type;
+    float x;
+    float y;
+    int value;
+};
+
+// Append-only queue of events of one type, cleared by its owner each step.
+// Capacity is kept across clears, so a warmed-up queue doesn't allocate.
+template <typename T>
+class EventQueue {
+private:
+    std::vector<T> events;
+
+public:
+    void push(const T& event) { events.push_back(event); }
+
+    // Appends other's events after this queue's (merging per-thread queues in order)
+    void append(const EventQueue& other) { events.insert(events.end(), other.events.begin(), other.events.end()); }
+
+    void clear() { events.clear(); }
+    void reserve(std::size_t count) { events.reserve(count); }
+
+    std::size_t size() const { return events.size(); }
+    bool empty() const { return events.empty(); }
+    const T& operator[](std::size_t index) const { return events[index]; }
+
+    typename std::vector<T>::const_iterator begin() const { return events.begin(); }
+    typename std::vector<T>::const_iterator end() const { return events.end(); }
+};
+
+using HitQueue = EventQueue<HitEvent>;
+using GameEventQueue = EventQueue<GameEvent>;
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <cstdint>
+
+// Gameplay actions, independent of the physical keys bound to them
+enum class InputAction {
+    UP,
+    DOWN,
+    LEFT,
+    RIGHT,
+    FIRE,
+    COUNT
+};
+
+// Edge (press/release) of an action with the time it was sampled
+struct InputEvent {
+    std::int64_t timestampUs;
+    InputAction action;
+    bool pressed;
+};
+
+// Held state of all actions as seen by the simulation
+struct PlayerInput {
+    bool up = false;
+    bool down = false;
+    bool left = false;
+    bool right = false;
+    bool fire = false;
+
+    void apply(const InputEvent& event);
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef INPUT_SAMPLER_H
+#define INPUT_SAMPLER_H
+
+#include <atomic>
+#include <thread>
+#include "Input.h"
+#include "SpscQueue.h"
+
+// Polls the keyboard at a fixed rate (independent of the frame rate) and
+// pushes timestamped action edges to the simulation through a lock-free queue
+class InputSampler {
+private:
+    SpscQueue<InputEvent, 256> events;
+    bool held[static_cast<int>(InputAction::COUNT)];
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<unsigned int> droppedEvents;
+    std::atomic<bool> resyncRequested;
+    int rateHz;
+
+    void samplerLoop();
+
+public:
+    InputSampler();
+    ~InputSampler();
+
+    InputSampler(const InputSampler&) = delete;
+    InputSampler& operator=(const InputSampler&) = delete;
+
+    // Start/stop the sampling thread
+    void start(int hz = 1000);
+    void stop();
+    bool isRunning() const;
+    int getRate() const;
+
+    // Poll once on the calling thread (per-frame sampling when the thread is not used)
+    void sampleOnce();
+
+    // Consumer side (simulation thread)
+    const InputEvent* peek() const;
+    bool pop(InputEvent& event);
+    void discardPending();
+
+    // Forgets which keys are held: keys still down are reported as new
+    // presses on the next sample, so a fresh PlayerInput picks them up
+    void resync();
+
+    unsigned int getDroppedEvents() const;
+
+    // Monotonic timestamp shared by sampler and simulation
+    static std::int64_t now();
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef INPUT_SOURCE_H
+#define INPUT_SOURCE_H
+
+#include <cstdint>
+#include <random>
+#include "Input.h"
+
+class Simulation;
+
+// Provides the held input for each simulation tick (bots, scripts, replays)
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    virtual PlayerInput nextInput(const Simulation& simulation) = 0;
+};
+
+// Seeded random walk: holds a direction for a while, then picks a new one; always firing
+class ScriptedInput : public InputSource {
+private:
+    std::mt19937 rng;
+    PlayerInput current;
+    int ticksLeft;
+
+public:
+    explicit ScriptedInput(std::uint32_t seed);
+
+    PlayerInput nextInput(const Simulation& simulation) override;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef LATENCY_METER_H
+#define LATENCY_METER_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Collects input-to-display latency samples in a 0.25 ms histogram
+class LatencyMeter {
+private:
+    static const int BUCKET_US = 250;
+    static const int BUCKET_COUNT = 400;    // Up to 100 ms, last bucket is overflow
+
+    std::vector<unsigned int> buckets;
+    unsigned int sampleCount;
+    std::int64_t totalUs;
+    std::int64_t maxUs;
+
+    std::int64_t percentile(float fraction) const;
+
+public:
+    LatencyMeter();
+
+    void addSample(std::int64_t latencyUs);
+    void reset();
+
+    unsigned int getSampleCount() const;
+    void report(std::ostream& out, const std::string& label) const;
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Authored level file (little-endian):
+//   [Header][PathName x pathCount][Formation x formationCount][FormationMember x memberCount]
+//   [Chunk]...  with Chunk = [ChunkHeader][SpawnRecord x recordCount]
+// Chunks hold the spawns of consecutive time windows in tick order. There is
+// no chunk index: opening reads only the header and tables, whatever the
+// level's length, and the reader walks the chunks as the clock reaches them.
+namespace LevelFormat {
+    const char MAGIC[4] = {'S', 'S', 'L', 'V'};
+    const std::uint32_t VERSION = 1;
+    const std::uint32_t TICKS_PER_SECOND = 120;     // Simulation rate that record times count in
+    const std::uint32_t DEFAULT_CHUNK_TICKS = 600;  // 5 s at 120 Hz
+    const std::uint32_t MAX_CHUNK_TICKS = 65536;    // Record offsets are 16 bits
+    const std::size_t MAX_PATH_NAME = 32;
+    const std::uint32_t MAX_TABLE_SIZE = 255;       // Paths and formations (8-bit references)
+    const std::uint32_t MAX_MEMBERS = 4096;         // Formation members over all formations
+    const std::uint8_t NO_FORMATION = 0xFF;
+    const std::uint8_t NO_PATTERN = 0xFF;
+
+    // Firing pattern names by record index (the simulation's pattern table follows this order)
+    const char* const PATTERN_NAMES[] = {"spread", "spiral", "burst"};
+    const int PATTERN_COUNT = 3;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t chunkTicks;       // Time window of one chunk
+        std::uint32_t pathCount;
+        std::uint32_t formationCount;
+        std::uint32_t memberCount;
+        std::uint32_t chunkCount;
+        std::uint32_t recordCount;
+        std::uint64_t lengthTicks;      // Tick of the last spawn record
+        std::uint64_t firstChunkOffset;
+    };
+
+    // Path referenced by name, resolved against the game's path set on load
+    struct PathName {
+        char name[MAX_PATH_NAME];       // Null-terminated
+    };
+
+    // Group of enemies spawned by one record, relative to its position and tick
+    struct Formation {
+        std::uint32_t firstMember;
+        std::uint32_t memberCount;
+    };
+
+    struct FormationMember {
+        std::int16_t dx;
+        std::int16_t dy;                // Negative = further above the spawn line
+        std::uint16_t delayTicks;
+        std::uint16_t reserved;
+    };
+
+    struct ChunkHeader {
+        std::uint64_t startTick;
+        std::uint32_t recordCount;
+        std::uint32_t reserved;
+    };
+
+    struct SpawnRecord {
+        std::uint16_t tickOffset;       // From the chunk's startTick, below chunkTicks
+        std::int16_t x;                 // Field x of the enemy (or formation anchor)
+        std::uint8_t path;
+        std::uint8_t formation;         // NO_FORMATION = a single enemy
+        std::uint8_t pattern;           // Firing pattern, NO_PATTERN = unarmed
+        std::uint8_t speedTenths;       // Path time scale x10 (10 = as authored)
+        std::uint16_t fireDelayMs;      // Before the first shot (armed enemies)
+        std::uint16_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 48, "Level header layout changed");
+    static_assert(sizeof(PathName) == 32, "Level path layout changed");
+    static_assert(sizeof(Formation) == 8, "Level formation layout changed");
+    static_assert(sizeof(FormationMember) == 8, "Level formation member layout changed");
+    static_assert(sizeof(ChunkHeader) == 16, "Level chunk layout changed");
+    static_assert(sizeof(SpawnRecord) == 12, "Level record layout changed");
+}
+
+// One enemy to spawn, with formations already expanded
+struct LevelSpawn {
+    std::uint64_t tick;
+    std::uint32_t path;             // Index into the level's path table
+    float x;
+    float dy;                       // Offset from the spawn line
+    int pattern;                    // -1 = unarmed
+    float timeScale;
+    float fireDelay;                // Seconds
+};
+
+// Reads a level file incrementally from a read-only mapping. Only the chunk
+// under the clock is decoded; the pages ahead of it are prefetched and the
+// ones behind it released, so memory stays constant however long the level is.
+class LevelStream {
+private:
+    const std::uint8_t* base;
+    std::size_t fileSize;
+    LevelFormat::Header header;
+    std::vector<std::string> pathNames;
+    std::vector<LevelFormat::Formation> formations;
+    std::vector<LevelFormat::FormationMember> members;
+
+    // Cursor
+    std::uint64_t chunkOffset;          // Current chunk, fileSize when done
+    LevelFormat::ChunkHeader chunk;
+    bool chunkLoaded;
+    std::uint32_t nextRecord;
+    std::uint64_t lastTick;             // Records must not go back in time
+    std::size_t prefetchedTo;           // Pages advised (ahead) and released (behind)
+    std::size_t releasedTo;
+    bool failed;
+
+    // Expanded spawns waiting for their tick (formation delays), in tick order
+    std::vector<LevelSpawn> pending;
+
+    bool loadChunk();
+    void advanceWindow();
+    void expand(const LevelFormat::SpawnRecord& record, std::uint64_t tick);
+
+public:
+    LevelStream();
+    ~LevelStream();
+
+    LevelStream(const LevelStream&) = delete;
+    LevelStream& operator=(const LevelStream&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Back to the first chunk (a new session on the same level)
+    void rewind();
+
+    // Appends every spawn due at or before tick to out, in tick order
+    void poll(std::uint64_t tick, std::vector<LevelSpawn>& out);
+
+    // All records read (or the rest was corrupt) and nothing pending
+    bool isFinished() const;
+
+    const std::vector<std::string>& getPathNames() const;
+    std::uint64_t getLength() const;
+    std::uint32_t getRecordCount() const;
+};
+
+// Writes level files front to back: paths and formations first, then spawns
+// in tick order. Only the chunk being filled is kept in memory.
+class LevelWriter {
+private:
+    std::uint32_t chunkTicks;
+    std::vector<LevelFormat::PathName> paths;
+    std::vector<LevelFormat::Formation> formations;
+    std::vector<LevelFormat::FormationMember> members;
+
+    std::FILE* file;
+    LevelFormat::Header header;
+    std::uint64_t chunkStart;
+    std::vector<LevelFormat::SpawnRecord> chunkRecords;
+    bool ok;
+
+    bool flushChunk();
+
+public:
+    explicit LevelWriter(std::uint32_t chunkTicks = LevelFormat::DEFAULT_CHUNK_TICKS);
+    ~LevelWriter();
+
+    LevelWriter(const LevelWriter&) = delete;
+    LevelWriter& operator=(const LevelWriter&) = delete;
+
+    // Table index for the name (added once); -1 if the table is full or the name too long
+    int addPath(const std::string& name);
+    int addFormation(const std::vector<LevelFormat::FormationMember>& formationMembers);
+
+    // Tables are written here and can't change afterwards
+    bool begin(const std::string& path);
+
+    // tickOffset is filled in; ticks must not decrease
+    bool add(std::uint64_t tick, LevelFormat::SpawnRecord record);
+
+    // Writes the last chunk and the final header
+    bool finish();
+};
+
+#endif
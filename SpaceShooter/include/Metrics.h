@@ -0,0 +1,135 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A named value in Prometheus' text exposition format. Updates are relaxed
+// atomics, so any thread can update while the server thread reads; a scrape
+// sees each value as of some recent moment, not one snapshot of them all.
+// Names and help texts are not copied (string literals).
+class Metric {
+public:
+    Metric(const char* name, const char* help);
+    virtual ~Metric() {}
+
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    // Appends the # HELP and # TYPE lines and the samples
+    virtual void write(std::string& out) const = 0;
+
+protected:
+    const char* name;
+    const char* help;
+
+    void writeHeader(std::string& out, const char* type) const;
+};
+
+// Monotonic count (exported as name, which should end in _total)
+class MetricCounter : public Metric {
+public:
+    MetricCounter(const char* name, const char* help);
+
+    void add(std::uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    std::uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+    void write(std::string& out) const override;
+
+private:
+    std::atomic<std::uint64_t> value;
+};
+
+// Current value of something that goes up and down
+class MetricGauge : public Metric {
+public:
+    MetricGauge(const char* name, const char* help);
+
+    void set(double amount) { value.store(amount, std::memory_order_relaxed); }
+    double get() const { return value.load(std::memory_order_relaxed); }
+
+    void write(std::string& out) const override;
+
+private:
+    std::atomic<double> value;
+};
+
+// Observations counted into fixed buckets (upper bounds, ascending) plus +Inf
+class MetricHistogram : public Metric {
+public:
+    static const int MAX_BUCKETS = 16;
+
+    MetricHistogram(const char* name, const char* help, const std::vector<double>& bounds);
+
+    void observe(double amount);
+
+    void write(std::string& out) const override;
+
+private:
+    double bounds[MAX_BUCKETS];
+    int boundCount;
+    std::atomic<std::uint64_t> counts[MAX_BUCKETS + 1];    // Per bucket, not cumulative; last = above every bound
+    std::atomic<double> sum;
+};
+
+// Owns the metrics of a process. Registration takes a lock and is meant for
+// startup; the returned references stay valid for the registry's lifetime.
+class MetricsRegistry {
+public:
+    MetricCounter& counter(const char* name, const char* help);
+    MetricGauge& gauge(const char* name, const char* help);
+    MetricHistogram& histogram(const char* name, const char* help, const std::vector<double>& bounds);
+
+    // Every metric in registration order (reuses out's capacity)
+    void write(std::string& out) const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Metric>> metrics;
+};
+
+// Serves a registry as GET /metrics over HTTP/1.0 on a background thread, on
+// 127.0.0.1:port or on a Unix socket (curl --unix-socket PATH localhost/metrics).
+// One connection is handled at a time; the game never waits for it.
+class MetricsServer {
+public:
+    explicit MetricsServer(const MetricsRegistry& registry);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+
+    // address is a TCP port (0 picks a free one) or a socket path (contains
+    // a '/'). Returns false (and logs why) if it can't listen.
+    bool start(const std::string& address);
+    void stop();
+    bool isRunning() const;
+
+    // Where to scrape, e.g. http://127.0.0.1:9100/metrics
+    std::string getUrl() const;
+    int getPort() const;        // 0 for a Unix socket
+
+    std::uint64_t getScrapes() const;
+
+private:
+    const MetricsRegistry& registry;
+    int listenFd;
+    int port;                   // TCP, after binding
+    std::string socketPath;     // Unix socket, removed on stop()
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<std::uint64_t> scrapes;
+    std::string request;        // Server thread buffers, kept between connections
+    std::string body;
+    std::string response;
+
+    void serverLoop();
+    void serve(int fd);
+};
+
+#endif
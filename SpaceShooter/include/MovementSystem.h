@@ -0,0 +1,123 @@
+#ifndef MOVEMENT_SYSTEM_H
+#define MOVEMENT_SYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Fixed.h"
+
+enum class PathType {
+    LINEAR,         // Straight down
+    SINE_WEAVE,     // Down while weaving left and right
+    DIVE,           // Slow descent, then a fast dive
+    SPLINE          // Catmull-Rom curve through points relative to the spawn position
+};
+
+// Movement description shared by every enemy that follows it
+struct PathDefinition {
+    std::string name;
+    PathType type = PathType::LINEAR;
+    float speed = 100.f;            // Pixels per second downward (LINEAR, SINE_WEAVE, DIVE)
+    float amplitude = 0.f;          // Horizontal reach in pixels (SINE_WEAVE)
+    float frequency = 1.f;          // Weaves per second (SINE_WEAVE)
+    float diveDelay = 1.f;          // Seconds before diving (DIVE)
+    float diveSpeed = 300.f;        // Pixels per second while diving (DIVE)
+    float duration = 5.f;           // Seconds to traverse all points (SPLINE)
+    std::vector<sf::Vector2f> points;
+};
+
+using MoverHandle = std::uint32_t;
+
+// Evaluates enemy movement from path definitions. Movers are grouped per path
+// in flat arrays so each path is one branch-free loop over all its movers.
+class MovementSystem {
+private:
+    // Path constants converted once for the deterministic mode
+    struct FixedPath {
+        Fixed speed;
+        Fixed amplitude;
+        Fixed frequency;
+        Fixed diveDelay;
+        Fixed diveSpeed;
+        Fixed duration;
+        Fixed segmentsPerSecond;
+        std::vector<FixedVec2> points;
+    };
+
+    // Deterministic-mode state of one mover; elapsed time counts ticks
+    struct FixedMover {
+        Fixed elapsedTicks;
+        Fixed timeScale;
+        FixedVec2 origin;
+        FixedVec2 out;
+    };
+
+    struct PathBatch {
+        PathDefinition definition;
+        FixedPath fixedPath;
+        std::vector<FixedMover> fixedMovers;
+        std::vector<float> elapsed;
+        std::vector<float> timeScale;
+        std::vector<float> originX;
+        std::vector<float> originY;
+        std::vector<float> outX;
+        std::vector<float> outY;
+        std::vector<MoverHandle> owner;     // Handle of each slot, for swap-removal
+    };
+
+    struct Slot {
+        std::uint32_t path;
+        std::uint32_t index;
+    };
+
+    std::vector<PathBatch> batches;
+    std::vector<Slot> slots;                // Indexed by handle
+    std::vector<MoverHandle> freeHandles;
+
+    static void evaluate(PathBatch& batch);
+    static void evaluateFixed(PathBatch& batch, int ticksPerSecond);
+    static bool parsePath(const std::string& line, PathDefinition& path);
+
+public:
+    // Parses a path file without touching any system (shared by simulations)
+    static bool readPathFile(const std::string& filename, std::vector<PathDefinition>& paths);
+
+    // Same format from memory (e.g. an asset pack entry); source names it in errors
+    static bool readPathText(const std::string& text, const std::string& source, std::vector<PathDefinition>& paths);
+
+    static const MoverHandle INVALID_MOVER = 0xFFFFFFFFu;
+
+    MovementSystem();
+
+    // Replaces the path set with definitions from a text file; keeps the built-in
+    // paths if the file is missing or invalid
+    bool loadPaths(const std::string& filename);
+    void setPaths(const std::vector<PathDefinition>& paths);
+    void addPath(const PathDefinition& path);
+
+    std::size_t getPathCount() const;
+    int findPath(const std::string& name) const;
+    const PathDefinition& getPath(std::size_t index) const;
+
+    // timeScale > 1 makes the mover run its path faster (difficulty)
+    MoverHandle add(std::size_t path, float x, float y, float timeScale = 1.f);
+    void remove(MoverHandle handle);
+    void clear();
+
+    // Preallocate every path batch for this many movers, so adding them later
+    // doesn't grow any arrays
+    void reserve(std::size_t moversPerPath);
+
+    void update(float dt);
+    sf::Vector2f getPosition(MoverHandle handle) const;
+
+    // Deterministic mode: movers added with addFixed advance one tick per
+    // updateFixed in fixed point (float positions are mirrored for getPosition)
+    MoverHandle addFixed(std::size_t path, const FixedVec2& pos, Fixed timeScale);
+    void updateFixed(int ticksPerSecond);
+    const FixedVec2& getFixedPosition(MoverHandle handle) const;
+    std::size_t size() const;
+};
+
+#endif
@@ -2,6 +2,10 @@
 #define PARTICLE_H
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "TimingWheel.h"
+#include "RenderBackend.h"
 
 class Particle {
 private:
@@ -15,20 +19,48 @@ public:
     Particle(float x, float y, const sf::Texture& texture);
     
     void update(float dt);
-    void render(sf::RenderWindow& window);
+    void render(RenderBackend& backend);
     
+    // Ends the particle (its lifetime timer fired)
+    void expire();
     bool isActive() const;
+    float getMaxLifetime() const;
 };
 
+// Particles live in fixed slots; each one's end of life is a timer on the
+// attached wheel, which frees the slot for reuse
 class ParticleSystem {
 private:
     std::vector<Particle> particles;
+    std::vector<TimingWheel::TimerId> expiry;   // Lifetime timer per slot
+    std::vector<std::uint32_t> freeSlots;
+    float emissionScale = 1.f;
+    const sf::Texture* texture = nullptr;     // Looked up on the first explosion
+    TimingWheel* timers = nullptr;
+    float tickLength = 1.f / 60.f;
+
+    void retire(std::uint32_t slot);
 
 public:
+    // Room for this many live particles is allocated up front
+    static const std::size_t RESERVE = 1024;
+
+    ParticleSystem();
+
+    // Lifetimes are scheduled on timers, which advance once per tickLength seconds
+    void attach(TimingWheel& timers, float tickLength);
+
     void createExplosion(float x, float y, int particleCount = 20);
     void update(float dt);
-    void render(sf::RenderWindow& window);
+    void render(RenderBackend& backend);
+    
+    // Drops all particles and cancels their timers
     void clear();
+    
+    // Scales particle counts of new explosions (frame governor)
+    void setEmissionScale(float scale);
+
+    std::size_t getLiveCount() const;
 };
 
 #endif
@@ -2,22 +2,35 @@
 #define PLAYER_H
 
 #include "Entity.h"
+#include "Input.h"
 
 class Player : public Entity {
 private:
     int health;
     int maxHealth;
     float shootCooldown;
-    float shootTimer;
+    bool weaponReady;
+    PlayerInput input;
+
+    void handleInput();
 
 public:
-    Player();
+    explicit Player(const sf::Texture* texture);
     
     void update(float dt) override;
-    void handleInput(float dt);
     
-    bool canShoot();
-    void resetShootTimer();
+    // One tick of update() in fixed point (deterministic mode)
+    void updateFixed(int ticksPerSecond);
+    
+    // Held actions for the next updates (fed by the simulation tick)
+    void setInput(const PlayerInput& newInput);
+    const PlayerInput& getInput() const;
+    
+    // Firing disarms the weapon; whoever schedules the cooldown rearms it
+    bool canShoot() const;
+    void disarm();
+    void rearm();
+    float getShootCooldown() const;
     
     void takeDamage(int damage);
     int getHealth() const;
@@ -0,0 +1,37 @@
+#ifndef PLAYFIELD_H
+#define PLAYFIELD_H
+
+#include <SFML/Graphics.hpp>
+
+// Logical play-field coordinates. Gameplay, spawning and culling work in these
+// units whatever the window size; the game maps them onto the window with a
+// letterboxed view.
+class Playfield {
+public:
+    static constexpr float WIDTH = 800.f;
+    static constexpr float HEIGHT = 600.f;
+
+    // The player's center stays this far inside the edges
+    static constexpr float PLAYER_MARGIN = 20.f;
+
+    // Enemies enter above the top edge, away from the sides, and are dropped
+    // once they are this far below or beside the field
+    static constexpr float ENEMY_SPAWN_Y = -30.f;
+    static constexpr float ENEMY_SPAWN_MARGIN = 50.f;
+    static constexpr float ENEMY_CULL_BOTTOM = 50.f;
+    static constexpr float ENEMY_CULL_SIDE = 60.f;
+
+    // Offscreen distance before bullets are dropped and stars wrap
+    static constexpr float CULL_MARGIN = 20.f;
+
+    static sf::FloatRect bounds();
+
+    // View of the whole field, scaled uniformly to fit windowSize and centered
+    // with bars on the sides or top and bottom
+    static sf::View letterboxView(const sf::Vector2u& windowSize);
+
+    // Window pixels the field covers under letterboxView
+    static sf::Vector2u viewportPixels(const sf::Vector2u& windowSize);
+};
+
+#endif
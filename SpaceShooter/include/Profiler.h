@@ -0,0 +1,60 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <ostream>
+
+// Named zones for per-frame telemetry. Each zone collects the time spent in it
+// and, when allocation tracking is on, the heap allocations made while it was
+// the innermost zone on that thread (global operator new/delete are hooked in
+// Profiler.cpp). Disabled tracking costs one relaxed atomic load per allocation.
+class Profiler {
+public:
+    static const int MAX_ZONES = 32;
+
+    struct ZoneFrame {
+        const char* name;
+        std::uint64_t allocations;
+        std::uint64_t bytes;
+        double timeMs;
+    };
+
+    struct Frame {
+        std::uint64_t allocations = 0;  // All threads, including outside any zone
+        std::uint64_t bytes = 0;
+        std::uint64_t frees = 0;
+        int zoneCount = 0;
+        ZoneFrame zones[MAX_ZONES + 1];     // [0] is "(no zone)"
+    };
+
+    // Allocation hooks only count while enabled
+    static void setAllocationTracking(bool enabled);
+    static bool isAllocationTracking();
+
+    // Snapshot the counters since the previous endFrame
+    static const Frame& endFrame();
+    static const Frame& getLastFrame();
+
+    // Allocations per zone over the frame, largest first
+    static void report(std::ostream& out, const Frame& frame);
+
+    // Zone index for name (registered on first use; names must outlive the program)
+    static int zone(const char* name);
+};
+
+// Scoped zone: ProfileZone zone("simulation");
+class ProfileZone {
+private:
+    int index;
+    int previous;
+    std::int64_t startNs;
+
+public:
+    explicit ProfileZone(const char* name);
+    ~ProfileZone();
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#endif
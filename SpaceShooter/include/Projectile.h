@@ -0,0 +1,143 @@
+#ifndef PROJECTILE_H
+#define PROJECTILE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstring>
+#include <vector>
+#include "UniformGrid.h"
+#include "CollisionMask.h"
+#include "Fixed.h"
+#include "RenderBackend.h"
+
+// Enemy projectiles kept as contiguous arrays (structure of arrays) so the
+// per-tick update is a tight loop the compiler can vectorize
+class ProjectileSystem {
+private:
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::size_t count;
+    std::size_t capacity;
+
+    // Deterministic mode: fixed-point positions and per-tick velocities are
+    // authoritative; the float arrays mirror them for the grid, rendering and queries
+    std::vector<Fixed> fixedX;
+    std::vector<Fixed> fixedY;
+    std::vector<Fixed> fixedVX;
+    std::vector<Fixed> fixedVY;
+    int fixedTicksPerSecond;            // 0 = float mode
+
+    UniformGrid grid;
+    std::vector<std::uint32_t> hits;
+    sf::VertexArray vertices;
+
+public:
+    static constexpr float SIZE = 6.f;
+
+    explicit ProjectileSystem(std::size_t capacity = 65536);
+
+    // Returns false when the pool is full
+    bool spawn(float x, float y, float vx, float vy);
+
+    // Integrate, cull off-screen projectiles and rebuild the broad-phase grid
+    void update(float dt);
+
+    // Deterministic mode (ticksPerSecond > 0) or float mode (0); clears the system
+    void setFixedPoint(int ticksPerSecond);
+    bool spawnFixed(const FixedVec2& pos, const FixedVec2& velocity);
+    void updateFixed();
+
+    // Appends the indices of projectiles overlapping target to out, without
+    // removing them. With a mask (laid over target), only projectiles touching
+    // its opaque pixels count.
+    void findHits(const sf::FloatRect& target, const CollisionMask* mask, CollisionStats* stats,
+                  std::vector<std::uint32_t>& out) const;
+
+    // findHits on the fixed-point state
+    void findHitsFixed(const FixedRect& target, const CollisionMask* mask, CollisionStats* stats,
+                       std::vector<std::uint32_t>& out) const;
+
+    // Takes a hit projectile out of play (indices stay valid until the next update)
+    void remove(std::uint32_t index);
+
+    // findHits, then removes the hits; returns how many there were
+    int collide(const sf::FloatRect& target, const CollisionMask* mask = nullptr, CollisionStats* stats = nullptr);
+
+    // Calls visit(x, y, vx, vy) for projectiles near area (broad-phase only)
+    template <typename Visitor>
+    void queryArea(const sf::FloatRect& area, Visitor&& visit) const {
+        grid.query(area, [&](std::uint32_t i) { visit(posX[i], posY[i], velX[i], velY[i]); });
+    }
+
+    // Calls visit(x, y) with the authoritative position of every projectile:
+    // raw fixed-point values in deterministic mode, float bit patterns otherwise
+    template <typename Visitor>
+    void visitState(Visitor&& visit) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (fixedTicksPerSecond > 0) {
+                visit(static_cast<std::uint32_t>(fixedX[i].getRaw()), static_cast<std::uint32_t>(fixedY[i].getRaw()));
+            } else {
+                std::uint32_t x, y;
+                std::memcpy(&x, &posX[i], sizeof(x));
+                std::memcpy(&y, &posY[i], sizeof(y));
+                visit(x, y);
+            }
+        }
+    }
+
+    void render(RenderBackend& backend);
+    void clear();
+
+    std::size_t size() const;
+};
+
+enum class PatternType {
+    SPREAD,         // Fan of projectiles centered straight down
+    SPIRAL,         // Ring that rotates a little every volley
+    AIMED_BURST     // Short volleys aimed at the target
+};
+
+// Parameters of a firing pattern
+struct BulletPattern {
+    PatternType type;
+    int count;              // Projectiles per volley
+    float spreadDegrees;    // Fan width (SPREAD, AIMED_BURST)
+    float speed;            // Pixels per second
+    float interval;         // Seconds between volleys
+    float spinDegrees;      // Rotation per volley (SPIRAL)
+    int burstLength;        // Volleys before a pause (AIMED_BURST)
+    float burstPause;       // Seconds between bursts (AIMED_BURST)
+
+    static BulletPattern spread(int count, float spreadDegrees, float speed, float interval);
+    static BulletPattern spiral(int count, float spinDegrees, float speed, float interval);
+    static BulletPattern aimedBurst(int count, float spreadDegrees, float speed, float interval,
+                                    int burstLength, float burstPause);
+};
+
+// Fires a pattern from a moving origin into a ProjectileSystem
+class BulletEmitter {
+private:
+    BulletPattern pattern;
+    float timer;
+    float angle;
+    int burstShot;
+
+    // Deterministic mode: seconds to the next volley and spiral angle in turns
+    Fixed fixedTimer;
+    Fixed fixedAngle;
+
+    void fire(const sf::Vector2f& origin, const sf::Vector2f& target, ProjectileSystem& projectiles);
+    void fireFixed(const FixedVec2& origin, const FixedVec2& target, ProjectileSystem& projectiles);
+
+public:
+    BulletEmitter(const BulletPattern& pattern, float initialDelay = 0.f);
+
+    // Returns true if it fired this update
+    bool update(float dt, const sf::Vector2f& origin, const sf::Vector2f& target, ProjectileSystem& projectiles);
+
+    // One tick of update() in fixed point (deterministic mode)
+    bool updateFixed(const FixedVec2& origin, const FixedVec2& target, int ticksPerSecond, ProjectileSystem& projectiles);
+};
+
+#endif
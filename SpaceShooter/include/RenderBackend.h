@@ -0,0 +1,38 @@
+#ifndef RENDER_BACKEND_H
+#define RENDER_BACKEND_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+
+// Where the world is drawn. Everything the game world draws is a quad: a
+// sprite, or one of a batch of untextured quads (enemy projectiles).
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    // Quads of four vertices each, alpha-blended in order. Texture coordinates
+    // are in pixels; a null texture draws the vertex colors only.
+    virtual void drawQuads(const sf::Vertex* vertices, std::size_t vertexCount, const sf::Texture* texture) = 0;
+
+    // The sprite as one quad through its transform (nothing without a texture, as in SFML)
+    virtual void drawSprite(const sf::Sprite& sprite);
+
+    virtual const char* getName() const = 0;
+};
+
+// Draws through SFML into a render target (the window or a render texture)
+class SfmlRenderBackend : public RenderBackend {
+private:
+    sf::RenderTarget* target;
+
+public:
+    SfmlRenderBackend();
+
+    void setTarget(sf::RenderTarget& target);
+
+    void drawQuads(const sf::Vertex* vertices, std::size_t vertexCount, const sf::Texture* texture) override;
+    void drawSprite(const sf::Sprite& sprite) override;
+    const char* getName() const override;
+};
+
+#endif
@@ -5,33 +5,110 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "AssetPack.h"
+#include "CollisionMask.h"
+
+// Handle returned by the async loaders (index into the request list)
+using AssetHandle = std::size_t;
 
 // Singleton pattern for managing game resources
 class ResourceManager {
 private:
+    // Work item for the loader thread: decoded on the worker, uploaded on the main thread
+    struct AsyncJob {
+        enum class Kind { TEXTURE, FONT };
+
+        AssetHandle handle;
+        Kind kind;
+        std::string name;
+        std::string filename;
+        sf::Image image;
+        std::unique_ptr<sf::Font> font;
+        std::vector<std::uint8_t> buffer;
+        bool loaded;
+    };
+
     std::map<std::string, std::unique_ptr<sf::Texture>> textures;
     std::map<std::string, std::unique_ptr<sf::Font>> fonts;
+    std::map<std::string, CollisionMask> masks;
     
+    // Mounted asset pack; fonts decoded from compressed entries keep their bytes here
+    AssetPack pack;
+    std::map<std::string, std::vector<std::uint8_t>> fontBuffers;
+
+    // Async loading state
+    std::thread worker;
+    std::mutex jobMutex;
+    std::condition_variable jobCondition;
+    std::deque<AsyncJob> pendingJobs;
+    std::vector<AsyncJob> finishedJobs;
+    bool stopWorker = false;
+    std::vector<bool> assetReady;
+    std::map<std::string, AssetHandle> textureHandles;     // Per kind, like the assets: names may repeat across them
+    std::map<std::string, AssetHandle> fontHandles;
+    std::size_t completedCount = 0;
+
     ResourceManager() = default;
+    ~ResourceManager();
+
+    AssetHandle queueJob(AsyncJob::Kind kind, const std::string& name, const std::string& filename);
+    void workerLoop();
+    const std::uint8_t* readPacked(const std::string& filename, std::vector<std::uint8_t>& scratch,
+                                   std::size_t& size) const;
+    static sf::Image createPlaceholderImage();
 
 public:
     // Singleton instance
     static ResourceManager& getInstance();
-    
+
     // Delete copy constructor and assignment operator
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
+
+    // Map a packed asset archive; later loads look up their filename in it
+    // before falling back to the filesystem (mount before queueing async loads)
+    bool mountPack(const std::string& path);
+
+    // Whole contents of a data file, from the pack or else the filesystem; false if neither has it
+    bool readText(const std::string& filename, std::string& text) const;
     
     // Load and get texture
     sf::Texture& loadTexture(const std::string& name, const std::string& filename);
     sf::Texture& getTexture(const std::string& name);
-    
+
     // Load and get font
     sf::Font& loadFont(const std::string& name, const std::string& filename);
     sf::Font& getFont(const std::string& name);
-    
-    // Create procedural textures (for when we don't have image files)
+
+    // Async loading: files are decoded on a worker thread and the resource is
+    // available immediately under its name as a placeholder until uploaded.
+    // The upload replaces the texture in place, but a sprite bound to the
+    // 16x16 placeholder keeps that texture rect: once isReady() is true,
+    // re-bind it with setTexture(texture, true) or it draws cropped.
+    AssetHandle loadTextureAsync(const std::string& name, const std::string& filename);
+    AssetHandle loadFontAsync(const std::string& name, const std::string& filename);
+    bool isReady(AssetHandle handle) const;
+
+    // Upload finished decodes (must be called from the main thread, once per frame)
+    void processAsyncLoads();
+
+    // Fraction of async requests that are uploaded (1.0 when nothing is pending)
+    float getLoadingProgress() const;
+
+    // Create procedural textures (for when we don't have image files) and their collision masks
     void createProceduralTextures();
+
+    // Image behind a procedural texture ("player", "enemy", "bullet", "particle", "star");
+    // static so headless code can build masks without the singleton
+    static sf::Image createProceduralImage(const std::string& name);
+
+    // Collision mask of a procedural texture, or null
+    const CollisionMask* getMask(const std::string& name) const;
 };
 
 #endif
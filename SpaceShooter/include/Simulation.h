@@ -0,0 +1,179 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "Player.h"
+#include "Enemy.h"
+#include "Bullet.h"
+#include "Projectile.h"
+#include "MovementSystem.h"
+#include "SpatialIndex.h"
+#include "CollisionMask.h"
+#include "GameEvents.h"
+#include "TimingWheel.h"
+#include "Level.h"
+
+// Textures for simulation sprites; left null in headless runs (hitboxes don't depend on them)
+struct SpriteTextures {
+    const sf::Texture* player = nullptr;
+    const sf::Texture* enemy = nullptr;
+    const sf::Texture* bullet = nullptr;
+};
+
+// Pixel collision masks matching the sprites; null falls back to bounding boxes
+struct SpriteMasks {
+    const CollisionMask* player = nullptr;
+    const CollisionMask* enemy = nullptr;
+    const CollisionMask* bullet = nullptr;
+};
+
+struct SimulationConfig {
+    std::uint32_t seed = 0;
+    SpriteTextures textures;
+    SpriteMasks masks;
+    std::vector<PathDefinition> paths;      // Empty = built-in paths
+    std::string levelPath;                  // Empty = endless random spawns
+    bool fixedPoint = false;                // Deterministic fixed-point simulation (see Fixed.h)
+};
+
+// Gameplay state and rules for one session. Owns no window, reads no input
+// device and doesn't use the ResourceManager, so any number of independent,
+// seeded sessions can run side by side.
+class Simulation {
+private:
+    SimulationConfig config;
+    std::mt19937 rng;
+
+    // Game objects
+    std::unique_ptr<Player> player;
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    std::vector<std::unique_ptr<Enemy>> enemyPool;     // Dead enemies kept for reuse (no per-spawn allocation)
+    std::vector<Bullet> bullets;                        // By value; capacity is reused once warmed up
+    ProjectileSystem enemyProjectiles;
+    MovementSystem movement;
+
+    // Live enemies, updated incrementally as they move (targeting and threat queries)
+    SpatialIndex enemyIndex;
+
+    // Game stats
+    int score;
+    float difficultyLevel;
+    Fixed fixedDifficulty;              // Authoritative in fixed-point mode
+    bool over;
+    CollisionStats collisionStats;
+    std::uint64_t enemiesSpawned;
+
+    // Collision hits of the current step, and what resolving them caused
+    HitQueue hits;
+    std::vector<std::uint32_t> projectileHits;
+    GameEventQueue events;
+
+    // Cooldowns and spawns fire on their tick; timers.now() is the current tick
+    TimingWheel timers;
+    TimingWheel::TimerId spawnTimer;
+    std::uint64_t spawnInterval;        // Ticks between spawns at the current difficulty
+    std::uint64_t lastSpawnTick;
+
+    // Authored spawns (config.levelPath) replace the random spawner; the
+    // session ends once the level ran out and its last enemy is gone
+    LevelStream level;
+    std::vector<int> levelPaths;            // Level path table -> movement path
+    std::vector<LevelSpawn> levelSpawns;    // Due this tick
+
+    void scheduleSpawn();
+    void spawnEnemy();
+    void spawnEnemyFixed();
+    void spawnFromLevel();
+    Enemy& addEnemy(std::size_t path, float x, float y, float timeScale);
+    Enemy& addEnemyFixed(std::size_t path, const FixedVec2& pos, Fixed timeScale);
+    Enemy& placeEnemy(MoverHandle mover, float x, float y);
+    void updateEntities(const PlayerInput& input);
+    void updateEntitiesFixed(const PlayerInput& input);
+    void detectPlayerHits(HitQueue& out, CollisionStats& stats);
+    void resolveHits(const HitQueue& hits);
+    void cleanupEntities();
+
+    // AABB test, then the mask test when both sides have masks
+    static bool touches(const Entity& a, const CollisionMask* maskA, const Entity& b, const CollisionMask* maskB,
+                        CollisionStats& stats);
+    static bool touchesFixed(const Entity& a, const CollisionMask* maskA, const Entity& b, const CollisionMask* maskB,
+                             CollisionStats& stats);
+
+public:
+    // Length of one simulation step
+    static constexpr float TICK = 1.f / 120.f;
+    static const int TICKS_PER_SECOND = 120;
+
+    // Enemy and bullet containers are preallocated for this many, so normal play
+    // doesn't allocate once running (more only grows the containers)
+    static const std::size_t ENTITY_RESERVE = 128;
+
+    // Enemies constructed up front into the pool (more than are ever alive at once)
+    static const std::size_t ENEMY_POOL_PREFILL = 32;
+
+    // Damage the player takes from ramming an enemy and per enemy projectile
+    static const int RAM_DAMAGE = 20;
+    static const int PROJECTILE_DAMAGE = 5;
+
+    // Fixed-point difficulty stops rising here (score 12600); beyond it path
+    // speeds and spawn rates would leave the range Q16.16 math is tuned for
+    static const int MAX_FIXED_DIFFICULTY = 64;
+
+    // Difficulty of a score in fixed-point mode: 1 + score / 200, computed in
+    // 64 bits and capped at MAX_FIXED_DIFFICULTY, so any score is safe
+    static Fixed fixedDifficultyFor(int score);
+
+    explicit Simulation(const SimulationConfig& config = SimulationConfig());
+
+    // Timers call back into this instance, so it stays where it was built
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Start a fresh session with a new seed
+    void reset(std::uint32_t seed);
+
+    // Advance one TICK with the given held input
+    void step(const PlayerInput& input);
+
+    void render(RenderBackend& backend);
+
+    bool isOver() const;
+    int getScore() const;
+    float getDifficulty() const;
+    std::uint64_t getTick() const;
+    const CollisionStats& getCollisionStats() const;
+    std::uint64_t getEnemiesSpawned() const;        // This session
+    std::size_t getBulletCount() const;
+
+    // FNV-1a over tick, score, health and every position (raw fixed-point
+    // values in fixed-point mode, float bits otherwise); equal hashes mean
+    // sessions stayed in lockstep
+    std::uint64_t getStateHash() const;
+
+    const Player& getPlayer() const;
+    const std::vector<std::unique_ptr<Enemy>>& getEnemies() const;
+    const ProjectileSystem& getEnemyProjectiles() const;
+    const SpatialIndex& getEnemyIndex() const;
+
+    // Events of the last step, in resolve order (effects, sound, telemetry)
+    const GameEventQueue& getEvents() const;
+
+    // Bullet vs enemy detection over bullets [begin, end). Only reads the entities
+    // and appends hits bullet by bullet, so ranges can be checked on separate
+    // threads and their queues appended in range order.
+    static void detectBulletHits(const std::vector<Bullet>& bullets, std::size_t begin, std::size_t end,
+                                 const std::vector<std::unique_ptr<Enemy>>& enemies, const SpriteMasks& masks,
+                                 HitQueue& out, CollisionStats& stats, bool fixedPoint = false);
+
+    // Calls visit(enemy) for every enemy whose bounds overlap area
+    template <typename Visitor>
+    void queryEnemies(const sf::FloatRect& area, Visitor&& visit) const {
+        enemyIndex.query(area, [&](const Entity& entity) { visit(static_cast<const Enemy&>(entity)); });
+    }
+};
+
+#endif
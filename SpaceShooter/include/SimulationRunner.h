@@ -0,0 +1,52 @@
+#ifndef SIMULATION_RUNNER_H
+#define SIMULATION_RUNNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AutopilotInput.h"
+#include "CollisionMask.h"
+
+struct EngineMetrics;
+
+enum class BotType {
+    SCRIPTED,       // Seeded random walk, always firing
+    AUTOPILOT       // Threat-avoiding, aiming bot
+};
+
+struct BatchOptions {
+    int sessions = 1000;
+    int maxTicks = 120 * 120;               // Two minutes of game time per session
+    std::uint32_t seed = 1;                 // Session i uses seed + i
+    int threads = 0;                        // 0 = all hardware threads
+    BotType bot = BotType::SCRIPTED;
+    bool pixelCollisions = true;            // false = bounding boxes only
+    std::string pathFile = "assets/paths.txt";
+    std::string levelPath;                  // Empty = endless random spawns
+    bool fixedPoint = false;                // Deterministic fixed-point simulation
+    std::string metricsAddress;             // Non-empty: serve metrics on this port or socket path
+};
+
+struct SessionResult {
+    std::uint32_t seed = 0;
+    int score = 0;
+    std::uint64_t ticks = 0;
+    bool survived = false;                  // Still alive at maxTicks
+    std::uint64_t stateHash = 0;            // Simulation::getStateHash() at the end
+};
+
+struct BatchResult {
+    std::vector<SessionResult> sessions;    // Indexed by session, independent of the thread count
+    double wallSeconds = 0.0;
+    AutopilotInput::DecisionStats decisions;    // Autopilot decision cost over all sessions
+    CollisionStats collisions;
+};
+
+// Runs independent headless sessions on a pool of worker threads; finished
+// sessions are added to metrics when given
+BatchResult runSimulationBatch(const BatchOptions& options, EngineMetrics* metrics = nullptr);
+
+// Runs a batch and prints aggregate scores and throughput; returns a process exit code
+int runBatchReport(const BatchOptions& options);
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "RenderBackend.h"
+
+// Rasterizes the world's quads on the CPU into an RGBA framebuffer, for
+// render benchmarks and golden images on hosts without a display or GL.
+// Draw calls only record quads; finish() bins them into tiles and worker
+// threads rasterize whole tiles, each tile's quads in submission order, so
+// the image is the same for any thread count. Spans are blended four pixels
+// at a time with SSE2 when available, with integer math that the scalar path
+// matches bit for bit.
+//
+// Quads are drawn as axis-aligned rectangles from their first and third
+// vertex (the game never rotates sprites) with the first vertex's color,
+// nearest-texel sampling and SFML's alpha blending. The framebuffer is
+// opaque, like the window. Pixels are stored in memory as R, G, B, A bytes.
+class SoftwareRenderer : public RenderBackend {
+public:
+    static const int TILE_SIZE = 64;
+
+    struct Stats {
+        std::uint64_t frames = 0;
+        std::uint64_t quads = 0;            // Recorded with a non-empty footprint
+        std::uint64_t tileQuads = 0;        // Quad-tile pairs rasterized
+        std::uint64_t pixels = 0;           // Covered pixels (blended, before alpha tests)
+    };
+
+    // threads = 0 uses every hardware thread (the calling thread is one of them)
+    SoftwareRenderer(unsigned int width, unsigned int height, int threads = 0);
+    ~SoftwareRenderer() override;
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    // CPU copy of a texture's pixels; quads with an unregistered texture draw nothing
+    void addTexture(const sf::Texture* texture, const sf::Image& image);
+
+    // World area the framebuffer shows (an unrotated sf::View); defaults to one unit per pixel
+    void setView(const sf::FloatRect& area);
+
+    // Reallocates the framebuffer; textures and the view area are kept
+    void resize(unsigned int width, unsigned int height);
+
+    // Off forces the scalar span loop (for comparisons)
+    void setSimd(bool enabled);
+    bool isSimdAvailable() const;
+
+    // Starts a frame cleared to color
+    void clear(const sf::Color& color);
+
+    void drawQuads(const sf::Vertex* vertices, std::size_t vertexCount, const sf::Texture* texture) override;
+    const char* getName() const override;
+
+    // Rasterizes the frame's quads into the framebuffer; returns once every tile is done
+    void finish();
+
+    unsigned int getWidth() const;
+    unsigned int getHeight() const;
+    int getThreadCount() const;
+    const sf::Uint8* getPixels() const;
+    sf::Image toImage() const;
+
+    // FNV-1a over the framebuffer, for golden-image comparisons
+    std::uint64_t checksum() const;
+
+    const Stats& getStats() const;
+
+private:
+    struct Quad {
+        int left, top, right, bottom;       // Covered pixels, right and bottom exclusive
+        float u0, du;                       // Texel column at pixel 0's center, and per pixel
+        float v0, dv;
+        std::uint32_t color;
+        int texture;                        // -1 = untextured
+    };
+
+    struct TextureData {
+        const sf::Texture* key;
+        int width;
+        int height;
+        std::vector<std::uint32_t> texels;
+    };
+
+    unsigned int width;
+    unsigned int height;
+    int tilesX;
+    int tilesY;
+    std::vector<std::uint32_t> pixels;
+    std::vector<TextureData> textures;
+    std::vector<Quad> quads;
+    std::vector<std::vector<std::uint32_t>> tileQuads;     // Quad indices per tile, in submission order
+    std::uint32_t clearColor;
+    sf::FloatRect viewArea;
+    float scaleX, scaleY, offsetX, offsetY;
+    bool simd;
+    Stats stats;
+
+    // Worker threads wait for a new frame generation, then take tiles from nextTile
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::uint64_t generation;
+    int busyWorkers;
+    bool stopping;
+    std::atomic<int> nextTile;
+
+    void updateTransform();
+    void workerLoop();
+    void rasterizeTiles();
+    void rasterizeTile(int tile);
+    void blendSpan(std::uint32_t* dst, int count, const Quad& quad, int firstPixel, const std::uint32_t* texRow, int texWidth) const;
+};
+
+#endif
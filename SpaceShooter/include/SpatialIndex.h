@@ -0,0 +1,102 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "DynamicAabbTree.h"
+#include "Entity.h"
+
+struct RayHit {
+    const Entity* entity;
+    float fraction;         // 0 at the ray start, 1 at its end
+};
+
+// Spatial queries over live entities, backed by a DynamicAabbTree that is
+// updated incrementally as entities move. The tree prunes with fat boxes;
+// every result below is exact against the entity's current bounds.
+class SpatialIndex {
+private:
+    DynamicAabbTree tree;
+    std::vector<const Entity*> owners;     // Indexed by proxy id
+
+public:
+    using Proxy = int;
+    static const Proxy INVALID_PROXY = DynamicAabbTree::NULL_NODE;
+
+    explicit SpatialIndex(float margin = 8.f);
+
+    Proxy insert(const Entity& entity);
+    void remove(Proxy proxy);
+
+    // Call after the entity moved by (dx, dy); returns true if the tree was restructured
+    bool update(Proxy proxy, float dx, float dy);
+    void clear();
+    void reserve(std::size_t entities);
+
+    std::size_t size() const;
+    int getTreeHeight() const;
+
+    // Calls visit(entity) for every entity whose bounds overlap area
+    template <typename Visitor>
+    void query(const sf::FloatRect& area, Visitor&& visit) const {
+        Aabb box = Aabb::fromRect(area);
+        tree.query(box, [&](int proxy) {
+            const Entity* entity = owners[proxy];
+            if (Aabb::fromRect(entity->getBounds()).overlaps(box)) {
+                visit(*entity);
+            }
+        });
+    }
+
+    // Calls visit(entity) for every entity whose bounds intersect the circle (splash damage)
+    template <typename Visitor>
+    void queryRadius(const sf::Vector2f& center, float radius, Visitor&& visit) const {
+        float radiusSquared = radius * radius;
+        Aabb box{center.x - radius, center.y - radius, center.x + radius, center.y + radius};
+        tree.query(box, [&](int proxy) {
+            const Entity* entity = owners[proxy];
+            if (Aabb::fromRect(entity->getBounds()).distanceSquared(center.x, center.y) <= radiusSquared) {
+                visit(*entity);
+            }
+        });
+    }
+
+    // All entities the segment passes through, sorted along the ray (piercing laser).
+    // Returns the number of hits written to hits.
+    std::size_t raycastAll(const sf::Vector2f& from, const sf::Vector2f& to, std::vector<RayHit>& hits) const;
+
+    // First entity along the segment accepted by filter(entity), or {nullptr, 1}
+    template <typename Filter>
+    RayHit raycastFirst(const sf::Vector2f& from, const sf::Vector2f& to, Filter&& filter) const {
+        RayHit best{nullptr, 1.f};
+        tree.raycast(from.x, from.y, to.x, to.y, [&](int proxy, float maxFraction) {
+            const Entity* entity = owners[proxy];
+            float fraction;
+            if (!segmentHitsBounds(from, to, entity->getBounds(), fraction) || fraction > maxFraction ||
+                !filter(*entity)) {
+                return maxFraction;
+            }
+            best = RayHit{entity, fraction};
+            return fraction;    // Clip: only closer hits matter now
+        });
+        return best;
+    }
+
+    // Nearest entity (by distance to its bounds) accepted by filter(entity) within
+    // maxDistance, or nullptr (homing target selection)
+    template <typename Filter>
+    const Entity* nearest(const sf::Vector2f& point, float maxDistance, Filter&& filter) const {
+        int proxy = tree.nearest(point.x, point.y, maxDistance, [&](int leaf) {
+            const Entity* entity = owners[leaf];
+            if (!filter(*entity)) return -1.f;
+            return Aabb::fromRect(entity->getBounds()).distanceSquared(point.x, point.y);
+        });
+        return proxy == DynamicAabbTree::NULL_NODE ? nullptr : owners[proxy];
+    }
+
+    // Entry fraction of the segment into rect, if it crosses it
+    static bool segmentHitsBounds(const sf::Vector2f& from, const sf::Vector2f& to,
+                                  const sf::FloatRect& rect, float& fraction);
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+    // Indices grow monotonically; separate cache lines avoid false sharing
+    alignas(64) std::atomic<std::size_t> head{0};   // Next slot to read (consumer)
+    alignas(64) std::atomic<std::size_t> tail{0};   // Next slot to write (producer)
+    alignas(64) T items[Capacity];
+
+public:
+    // Producer side: returns false when full
+    bool push(const T& item) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: oldest item or nullptr when empty
+    const T* peek() const {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[h & (Capacity - 1)];
+    }
+
+    // Consumer side: returns false when empty
+    bool pop(T& item) {
+        const T* front = peek();
+        if (!front) {
+            return false;
+        }
+        item = *front;
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Tick-driven scheduler: callbacks fire on the exact tick they were scheduled
+// for, without polling pending timers every tick. Hierarchical wheel of LEVELS
+// rings of SLOTS lists; a timer goes into the ring matching how far away it is
+// and cascades down as its tick approaches. Schedule and cancel are O(1), and
+// timers are pooled nodes on intrusive lists, so a warmed-up wheel doesn't
+// allocate (callbacks capturing up to two pointers fit std::function's inline
+// storage).
+class TimingWheel {
+public:
+    using TimerId = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    TimingWheel();
+
+    // Fires callback delay ticks after the current tick (at least one)
+    TimerId schedule(std::uint64_t delay, Callback callback);
+
+    // Returns false if the timer already fired or was cancelled
+    bool cancel(TimerId id);
+    bool isPending(TimerId id) const;
+
+    // Moves to the next tick and fires its timers (in the order they were
+    // scheduled within a level). Callbacks may schedule and cancel timers.
+    void advance();
+
+    // Ticks advanced so far
+    std::uint64_t now() const;
+    std::size_t size() const;
+
+    // Drops all timers and restarts at tick 0
+    void clear();
+    void reserve(std::size_t timers);
+
+    // Whole ticks in seconds (rounded, at least one)
+    static std::uint64_t toTicks(float seconds, float tickLength);
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;                    // Covers 2^24 ticks (39 hours at 120 Hz); later timers re-cascade
+    static const int FIRING = LEVELS * SLOTS;       // List of the tick being fired
+    static const int NO_LIST = -1;
+
+    struct Node {
+        std::uint64_t expires;
+        Callback callback;
+        std::uint32_t generation;   // Bumped on release, so stale ids don't match
+        int list;                   // Slot list index, FIRING or NO_LIST when free
+        int prev;
+        int next;                   // Next free node while free
+    };
+
+    std::vector<Node> nodes;
+    int heads[FIRING + 1];
+    int tails[FIRING + 1];
+    int freeList;
+    std::uint64_t current;
+    std::size_t pending;
+
+    int allocateNode();
+    void releaseNode(int node);
+    void link(int node, int list);
+    void unlink(int node);
+
+    // Puts node in the list its expiry calls for, seen from tick base (the next
+    // tick to fire)
+    void place(int node, std::uint64_t base);
+    void cascade(int level, int index, std::uint64_t base);
+
+    int find(TimerId id) const;
+};
+
+#endif
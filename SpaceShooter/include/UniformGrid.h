@@ -0,0 +1,51 @@
+#ifndef UNIFORM_GRID_H
+#define UNIFORM_GRID_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Broad-phase grid over point positions, rebuilt in O(n) with a counting sort.
+// Items outside the covered area are clamped into the border cells.
+class UniformGrid {
+private:
+    float originX;
+    float originY;
+    float invCellSize;
+    int cols;
+    int rows;
+    std::vector<std::uint32_t> cellStart;   // Prefix sums: items of cell c are [cellStart[c], cellStart[c+1])
+    std::vector<std::uint32_t> items;       // Item indices grouped by cell
+    std::vector<std::uint32_t> itemCell;
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+public:
+    UniformGrid(float originX, float originY, float width, float height, float cellSize);
+
+    void build(const float* xs, const float* ys, std::size_t count);
+
+    // Preallocate for builds of up to count items
+    void reserve(std::size_t count);
+
+    // Calls visit(index) for every item in cells overlapping area (may include near misses)
+    template <typename Visitor>
+    void query(const sf::FloatRect& area, Visitor&& visit) const {
+        int x0 = cellX(area.left);
+        int x1 = cellX(area.left + area.width);
+        int y0 = cellY(area.top);
+        int y1 = cellY(area.top + area.height);
+
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                int cell = y * cols + x;
+                for (std::uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                    visit(items[i]);
+                }
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,258 @@
+#include "AssetPack.h"
+#include "Compression.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace AssetPackFormat;
+
+namespace {
+    // An LZ4 sequence expands at most about 255x; larger claimed sizes are corrupt
+    const std::uint64_t MAX_LZ4_RATIO = 255;
+}
+
+AssetPack::AssetPack() : base(nullptr), fileSize(0), entries(nullptr), entryCount(0) {}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+void AssetPack::close() {
+    if (base) {
+        munmap(const_cast<std::uint8_t*>(base), fileSize);
+    }
+    base = nullptr;
+    fileSize = 0;
+    entries = nullptr;
+    entryCount = 0;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        std::cerr << "Invalid asset pack: " << path << std::endl;
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map asset pack: " << path << std::endl;
+        return false;
+    }
+
+    base = static_cast<const std::uint8_t*>(mapping);
+    fileSize = size;
+
+    // Validate everything up front so lookups can trust the index (raw
+    // entries are read rawSize bytes straight from the mapping)
+    const Header* header = reinterpret_cast<const Header*>(base);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+              && header->version == VERSION
+              && header->alignment != 0
+              && (header->alignment & (header->alignment - 1)) == 0
+              && header->indexOffset % alignof(Entry) == 0
+              && header->indexOffset <= fileSize
+              && header->entryCount <= (fileSize - header->indexOffset) / sizeof(Entry);
+
+    if (valid) {
+        entries = reinterpret_cast<const Entry*>(base + header->indexOffset);
+        entryCount = header->entryCount;
+
+        for (std::uint32_t i = 0; i < entryCount && valid; ++i) {
+            const Entry& e = entries[i];
+            valid = std::memchr(e.name, '\0', MAX_NAME_LENGTH) != nullptr
+                 && e.offset <= fileSize
+                 && e.storedSize <= fileSize - e.offset
+                 && ((e.flags & FLAG_LZ4) ? e.rawSize <= e.storedSize * MAX_LZ4_RATIO : e.rawSize == e.storedSize)
+                 && (i == 0 || std::strcmp(entries[i - 1].name, e.name) < 0);
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Invalid asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    // Entries are read front to back when decoding
+    madvise(mapping, size, MADV_WILLNEED);
+    return true;
+}
+
+bool AssetPack::isOpen() const {
+    return base != nullptr;
+}
+
+const Entry* AssetPack::find(const std::string& name) const {
+    if (!base) return nullptr;
+
+    // Index is sorted by name
+    const Entry* end = entries + entryCount;
+    const Entry* it = std::lower_bound(entries, end, name,
+        [](const Entry& e, const std::string& key) { return std::strcmp(e.name, key.c_str()) < 0; });
+
+    if (it != end && name == it->name) {
+        return it;
+    }
+    return nullptr;
+}
+
+bool AssetPack::isCompressed(const Entry& entry) const {
+    return (entry.flags & FLAG_LZ4) != 0;
+}
+
+const std::uint8_t* AssetPack::data(const Entry& entry) const {
+    return base + entry.offset;
+}
+
+bool AssetPack::extract(const Entry& entry, std::vector<std::uint8_t>& out) const {
+    out.resize(entry.rawSize);
+
+    if (!isCompressed(entry)) {
+        std::memcpy(out.data(), data(entry), entry.rawSize);
+        return true;
+    }
+
+    if (!lz4Decompress(data(entry), entry.storedSize, out.data(), out.size())) {
+        std::cerr << "Corrupt asset pack entry: " << entry.name << std::endl;
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+std::uint32_t AssetPack::getEntryCount() const {
+    return entryCount;
+}
+
+// AssetPackWriter implementation
+AssetPackWriter::AssetPackWriter(std::uint32_t align) : alignment(align) {}
+
+bool AssetPackWriter::add(const std::string& name, std::vector<std::uint8_t> data, bool compress) {
+    if (name.empty() || name.size() >= MAX_NAME_LENGTH) {
+        std::cerr << "Asset name too long for pack: " << name << std::endl;
+        return false;
+    }
+
+    pending.push_back(PendingEntry{name, std::move(data), compress});
+    return true;
+}
+
+bool AssetPackWriter::addFile(const std::string& name, const std::string& filename, bool compress) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to read: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return add(name, std::move(data), compress);
+}
+
+bool AssetPackWriter::write(const std::string& path) const {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        std::cerr << "Pack alignment must be a power of two" << std::endl;
+        return false;
+    }
+
+    std::vector<const PendingEntry*> sorted;
+    for (const auto& p : pending) {
+        sorted.push_back(&p);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const PendingEntry* a, const PendingEntry* b) { return a->name < b->name; });
+
+    for (std::size_t i = 1; i < sorted.size(); ++i) {
+        if (sorted[i - 1]->name == sorted[i]->name) {
+            std::cerr << "Duplicate asset name: " << sorted[i]->name << std::endl;
+            return false;
+        }
+    }
+
+    auto alignUp = [this](std::uint64_t value) {
+        return (value + alignment - 1) & ~static_cast<std::uint64_t>(alignment - 1);
+    };
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entryCount = static_cast<std::uint32_t>(sorted.size());
+    header.alignment = alignment;
+    header.indexOffset = sizeof(Header);
+    header.reserved = 0;
+
+    std::vector<Entry> index(sorted.size());
+    std::vector<std::vector<std::uint8_t>> blobs(sorted.size());
+    std::uint64_t offset = alignUp(header.indexOffset + sorted.size() * sizeof(Entry));
+
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        const PendingEntry& p = *sorted[i];
+        Entry& e = index[i];
+        std::memset(&e, 0, sizeof(e));
+        std::memcpy(e.name, p.name.c_str(), p.name.size());
+        e.rawSize = p.data.size();
+
+        // Keep the compressed form only when it actually saves space
+        if (p.compress && !p.data.empty()) {
+            std::vector<std::uint8_t> packed(lz4CompressBound(p.data.size()));
+            std::size_t packedSize = lz4Compress(p.data.data(), p.data.size(), packed.data(), packed.size());
+            if (packedSize > 0 && packedSize < p.data.size()) {
+                packed.resize(packedSize);
+                blobs[i] = std::move(packed);
+                e.flags |= FLAG_LZ4;
+            }
+        }
+        if (!(e.flags & FLAG_LZ4)) {
+            blobs[i] = p.data;
+        }
+
+        e.storedSize = blobs[i].size();
+        e.offset = offset;
+        offset = alignUp(offset + e.storedSize);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Failed to create pack: " << path << std::endl;
+        return false;
+    }
+
+    std::uint64_t written = 0;
+    auto writeBytes = [&out, &written](const void* bytes, std::size_t size) {
+        out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        written += size;
+    };
+    auto padTo = [&](std::uint64_t target) {
+        static const char zeros[256] = {};
+        while (written < target) {
+            std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(target - written, sizeof(zeros)));
+            writeBytes(zeros, chunk);
+        }
+    };
+
+    writeBytes(&header, sizeof(header));
+    writeBytes(index.data(), index.size() * sizeof(Entry));
+    for (std::size_t i = 0; i < index.size(); ++i) {
+        padTo(index[i].offset);
+        writeBytes(blobs[i].data(), blobs[i].size());
+    }
+    padTo(offset);
+
+    return static_cast<bool>(out);
+}
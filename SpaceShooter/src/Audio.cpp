@@ -0,0 +1,411 @@
+#include "Audio.h"
+#include "Playfield.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    const float PI = 3.14159265f;
+    const int SOUND_COUNT = static_cast<int>(SoundId::COUNT);
+
+    // Per sound: how much it matters when voices run out, its volume, and how
+    // many copies may overlap (a wall of identical explosions is just noise)
+    const float PRIORITY[SOUND_COUNT] = {2.f, 1.f, 3.f, 4.f};
+    const float VOLUME[SOUND_COUNT] = {0.35f, 0.3f, 0.8f, 0.9f};
+    const int MAX_INSTANCES[SOUND_COUNT] = {6, 8, 10, 3};
+
+    // Distance (field units) at which gain halves; quieter requests are culled
+    const float REFERENCE_DISTANCE = 300.f;
+    const float MIN_GAIN = 0.03f;
+    const float PAN_WIDTH = 0.8f;
+
+    // Stolen voices fade out over this many frames (1.5 ms) instead of clicking off
+    const std::uint32_t FADE_FRAMES = 64;
+
+    const std::size_t MIX_BLOCK = 512;          // Frames accumulated at a time
+    const float MASTER_GAIN = 0.5f;
+    const std::size_t OFFLINE_BUFFER = 8192;    // Frames, more than one capped frame (0.1 s)
+    const std::size_t DEVICE_BLOCK = 1024;      // Frames per chunk handed to the device (23 ms)
+
+    std::uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Deterministic noise source for the synthesized sounds
+    struct Noise {
+        std::uint32_t state = 0x12345678u;
+        float next() {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<int>(state >> 8) / float(1 << 23) - 1.f;
+        }
+    };
+
+    std::vector<std::int16_t> synthesize(SoundId sound) {
+        const float rate = static_cast<float>(AudioMixer::SAMPLE_RATE);
+        float seconds = 0.f;
+        switch (sound) {
+            case SoundId::PLAYER_SHOT: seconds = 0.12f; break;
+            case SoundId::ENEMY_SHOT:  seconds = 0.15f; break;
+            case SoundId::EXPLOSION:   seconds = 0.9f;  break;
+            case SoundId::PLAYER_HIT:  seconds = 0.3f;  break;
+            case SoundId::COUNT:       break;
+        }
+
+        std::vector<std::int16_t> samples(static_cast<std::size_t>(seconds * rate));
+        Noise noise;
+        float phase = 0.f;
+        float lowpass = 0.f;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            float t = i / rate;
+            float u = t / seconds;      // 0..1 over the sound
+            float value = 0.f;
+            switch (sound) {
+                case SoundId::PLAYER_SHOT:
+                    // Square wave sweeping down
+                    phase += (1200.f - 800.f * u) / rate;
+                    value = (std::fmod(phase, 1.f) < 0.5f ? 0.6f : -0.6f) * std::exp(-6.f * u);
+                    break;
+                case SoundId::ENEMY_SHOT:
+                    phase += (600.f - 400.f * u) / rate;
+                    value = std::sin(2.f * PI * phase) * std::exp(-5.f * u);
+                    break;
+                case SoundId::EXPLOSION:
+                    // Low-passed noise with a long tail
+                    lowpass += (noise.next() - lowpass) * (0.25f - 0.2f * u);
+                    value = 2.f * lowpass * std::exp(-4.f * u);
+                    break;
+                case SoundId::PLAYER_HIT:
+                    phase += 120.f / rate;
+                    value = (0.5f * noise.next() + (std::fmod(phase, 1.f) < 0.5f ? 0.5f : -0.5f)) * std::exp(-5.f * u);
+                    break;
+                case SoundId::COUNT:
+                    break;
+            }
+            // Short attack so sounds don't start with a click either
+            value *= std::min(1.f, t * 1000.f);
+            samples[i] = static_cast<std::int16_t>(std::max(-1.f, std::min(1.f, value)) * 32767.f);
+        }
+        return samples;
+    }
+}
+
+AudioMixer::AudioMixer(std::size_t voiceCount)
+    : voices(voiceCount > 0 ? voiceCount : DEFAULT_VOICES)
+    , scratch(MIX_BLOCK * CHANNELS)
+    , listenerX(Playfield::WIDTH / 2.f)
+    , listenerY(Playfield::HEIGHT)
+    , instanceLimits(true)
+    , requestCount(0)
+    , droppedCount(0)
+    , inaudibleCount(0)
+    , activeVoices(0) {
+}
+
+void AudioMixer::createSounds() {
+    for (int i = 0; i < SOUND_COUNT; ++i) {
+        sounds[i] = synthesize(static_cast<SoundId>(i));
+    }
+}
+
+void AudioMixer::setInstanceLimits(bool enabled) {
+    instanceLimits = enabled;
+}
+
+void AudioMixer::setListener(float x, float y) {
+    listenerX = x;
+    listenerY = y;
+}
+
+void AudioMixer::play(SoundId sound, float x, float y) {
+    ++requestCount;
+    int index = static_cast<int>(sound);
+
+    float dx = x - listenerX;
+    float dy = y - listenerY;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    float gain = VOLUME[index] / (1.f + distance / REFERENCE_DISTANCE);
+    if (gain < MIN_GAIN) {
+        ++inaudibleCount;
+        return;
+    }
+
+    float pan = std::max(-1.f, std::min(1.f, dx / (Playfield::WIDTH / 2.f))) * PAN_WIDTH;
+    if (!requests.push(Request{sound, gain, pan})) {
+        ++droppedCount;
+    }
+}
+
+void AudioMixer::mix(std::int16_t* out, std::size_t frames) {
+    auto begin = std::chrono::steady_clock::now();
+
+    Request request;
+    while (requests.pop(request)) {
+        start(request);
+    }
+
+    for (std::size_t done = 0; done < frames; done += MIX_BLOCK) {
+        std::size_t block = std::min(MIX_BLOCK, frames - done);
+        mixBlock(out + done * CHANNELS, block);
+    }
+
+    int active = 0;
+    for (const Voice& voice : voices) {
+        active += voice.active ? 1 : 0;
+    }
+    activeVoices.store(active, std::memory_order_relaxed);
+
+    std::uint64_t ns = elapsedNs(begin);
+    stats.mixedFrames += frames;
+    stats.mixNs += ns;
+    stats.mixMaxNs = std::max(stats.mixMaxNs, ns);
+    ++stats.mixCalls;
+}
+
+void AudioMixer::start(const Request& request) {
+    int index = static_cast<int>(request.sound);
+    float importance = PRIORITY[index] * request.gain;
+
+    // One pass: a free voice, the least important voice overall and the least
+    // important copy of this sound. Voices already stolen can't be stolen again.
+    Voice* freeVoice = nullptr;
+    Voice* weakest = nullptr;
+    Voice* weakestCopy = nullptr;
+    float weakestImportance = 0.f;
+    float weakestCopyImportance = 0.f;
+    int instances = 0;
+    int active = 0;
+    for (Voice& voice : voices) {
+        if (!voice.active) {
+            if (!freeVoice) freeVoice = &voice;
+            continue;
+        }
+        ++active;
+        if (voice.hasNext) {
+            if (voice.next.sound == request.sound) ++instances;
+            continue;
+        }
+
+        float current = currentImportance(voice);
+        if (voice.sound == request.sound) {
+            ++instances;
+            if (!weakestCopy || current < weakestCopyImportance) {
+                weakestCopy = &voice;
+                weakestCopyImportance = current;
+            }
+        }
+        if (!weakest || current < weakestImportance) {
+            weakest = &voice;
+            weakestImportance = current;
+        }
+    }
+
+    Voice* victim = nullptr;
+    float victimImportance = 0.f;
+    if (instanceLimits && instances >= MAX_INSTANCES[index]) {
+        victim = weakestCopy;
+        victimImportance = weakestCopyImportance;
+    } else if (freeVoice) {
+        assign(*freeVoice, request);
+        ++stats.played;
+        stats.peakVoices = std::max(stats.peakVoices, active + 1);
+        return;
+    } else {
+        victim = weakest;
+        victimImportance = weakestImportance;
+    }
+
+    if (!victim || victimImportance >= importance) {
+        ++stats.culled;
+        return;
+    }
+
+    // The new sound starts once the old one has faded out
+    victim->fade = std::min(FADE_FRAMES, victim->length - victim->position);
+    victim->hasNext = true;
+    victim->next = request;
+    ++stats.stolen;
+}
+
+void AudioMixer::assign(Voice& voice, const Request& request) {
+    const std::vector<std::int16_t>& samples = sounds[static_cast<int>(request.sound)];
+    float angle = (request.pan + 1.f) * PI / 4.f;   // Equal-power panning
+
+    voice.samples = samples.data();
+    voice.length = static_cast<std::uint32_t>(samples.size());
+    voice.position = 0;
+    voice.gainLeft = request.gain * std::cos(angle);
+    voice.gainRight = request.gain * std::sin(angle);
+    voice.importance = PRIORITY[static_cast<int>(request.sound)] * request.gain;
+    voice.fade = 0;
+    voice.sound = request.sound;
+    voice.active = voice.length > 0;
+    voice.hasNext = false;
+}
+
+float AudioMixer::currentImportance(const Voice& voice) const {
+    // A sound near its end (mostly decay) is cheaper to cut than one just started
+    float remaining = voice.length > 0 ? float(voice.length - voice.position) / voice.length : 0.f;
+    return voice.importance * (0.25f + 0.75f * remaining);
+}
+
+void AudioMixer::mixBlock(std::int16_t* out, std::size_t frames) {
+    std::fill(scratch.begin(), scratch.begin() + frames * CHANNELS, 0.f);
+
+    for (Voice& voice : voices) {
+        std::size_t offset = 0;
+        while (voice.active && offset < frames) {
+            std::uint32_t count = static_cast<std::uint32_t>(std::min<std::size_t>(frames - offset, voice.length - voice.position));
+            const std::int16_t* samples = voice.samples + voice.position;
+            float* mixed = &scratch[offset * CHANNELS];
+
+            if (voice.fade > 0) {
+                // Linear ramp down to silence, then the queued sound takes over
+                count = std::min(count, voice.fade);
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    float ramp = float(voice.fade - i) / FADE_FRAMES;
+                    mixed[i * 2] += samples[i] * voice.gainLeft * ramp;
+                    mixed[i * 2 + 1] += samples[i] * voice.gainRight * ramp;
+                }
+                voice.fade -= count;
+            } else {
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    mixed[i * 2] += samples[i] * voice.gainLeft;
+                    mixed[i * 2 + 1] += samples[i] * voice.gainRight;
+                }
+            }
+
+            voice.position += count;
+            offset += count;
+            if (voice.fade == 0 && voice.hasNext) {
+                assign(voice, voice.next);
+            } else if (voice.position >= voice.length || (voice.fade == 0 && count == 0)) {
+                voice.active = false;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < frames * CHANNELS; ++i) {
+        float value = scratch[i] * MASTER_GAIN;
+        out[i] = static_cast<std::int16_t>(std::max(-32768.f, std::min(32767.f, value)));
+    }
+}
+
+int AudioMixer::getActiveVoices() const {
+    return activeVoices.load(std::memory_order_relaxed);
+}
+
+std::size_t AudioMixer::getVoiceCount() const {
+    return voices.size();
+}
+
+AudioMixer::Stats AudioMixer::getStats() const {
+    Stats merged = stats;
+    merged.requests = requestCount;
+    merged.dropped = droppedCount;
+    merged.culled += inaudibleCount;
+    return merged;
+}
+
+void AudioMixer::report(std::ostream& out) const {
+    Stats s = getStats();
+    out << "Audio (" << voices.size() << " voices): " << s.requests << " requests, " << s.played << " played, "
+        << s.stolen << " stolen, " << s.culled << " culled, " << s.dropped << " dropped; peak "
+        << s.peakVoices << " voices" << std::endl;
+
+    // Cost per 60 Hz frame's worth of audio
+    double frames60 = s.mixedFrames / (SAMPLE_RATE / 60.0);
+    double perFrameUs = frames60 > 0.0 ? s.mixNs / 1000.0 / frames60 : 0.0;
+    out << "  mixing: " << perFrameUs << " us per 60 Hz frame, slowest call " << s.mixMaxNs / 1000.0
+        << " us (" << s.mixCalls << " calls, " << s.mixedFrames / double(SAMPLE_RATE) << " s of audio)" << std::endl;
+}
+
+NullAudioBackend::NullAudioBackend()
+    : mixer(nullptr)
+    , buffer(OFFLINE_BUFFER * AudioMixer::CHANNELS)
+    , pendingFrames(0.0) {
+}
+
+bool NullAudioBackend::start(AudioMixer& target) {
+    mixer = &target;
+    pendingFrames = 0.0;
+    return true;
+}
+
+void NullAudioBackend::stop() {
+    mixer = nullptr;
+}
+
+void NullAudioBackend::update(float dt) {
+    if (!mixer) return;
+
+    // Whole frames of the elapsed time; the fraction carries over
+    pendingFrames += dt * AudioMixer::SAMPLE_RATE;
+    std::size_t frames = static_cast<std::size_t>(pendingFrames);
+    pendingFrames -= static_cast<double>(frames);
+
+    while (frames > 0) {
+        std::size_t block = std::min(frames, OFFLINE_BUFFER);
+        mixer->mix(buffer.data(), block);
+        frames -= block;
+    }
+}
+
+const char* NullAudioBackend::getName() const {
+    return "offline";
+}
+
+DeviceAudioBackend::DeviceAudioBackend()
+    : mixer(nullptr)
+    , buffer(DEVICE_BLOCK * AudioMixer::CHANNELS) {
+}
+
+DeviceAudioBackend::~DeviceAudioBackend() {
+    // The streaming thread calls onGetData; it must be gone before this object is
+    stop();
+}
+
+bool DeviceAudioBackend::start(AudioMixer& target) {
+    mixer = &target;
+    initialize(AudioMixer::CHANNELS, AudioMixer::SAMPLE_RATE);
+    play();
+    if (getStatus() != sf::SoundSource::Playing) {
+        std::cerr << "Failed to open the audio device" << std::endl;
+        mixer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void DeviceAudioBackend::stop() {
+    sf::SoundStream::stop();
+    mixer = nullptr;
+}
+
+bool DeviceAudioBackend::onGetData(Chunk& data) {
+    mixer->mix(buffer.data(), DEVICE_BLOCK);
+    data.samples = buffer.data();
+    data.sampleCount = buffer.size();
+    return true;
+}
+
+void DeviceAudioBackend::onSeek(sf::Time) {
+    // Live stream, nothing to seek
+}
+
+const char* DeviceAudioBackend::getName() const {
+    return "device";
+}
+
+std::unique_ptr<AudioBackend> createAudioBackend(AudioOutput output) {
+    switch (output) {
+        case AudioOutput::DEVICE:
+            return std::make_unique<DeviceAudioBackend>();
+        case AudioOutput::OFFLINE:
+            return std::make_unique<NullAudioBackend>();
+        case AudioOutput::OFF:
+            break;
+    }
+    return nullptr;
+}
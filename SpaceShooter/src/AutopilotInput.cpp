@@ -0,0 +1,157 @@
+#include "AutopilotInput.h"
+#include "Simulation.h"
+#include "Playfield.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    const float PLAYER_SPEED = 300.f;
+    const float LOOKAHEAD = 0.45f;          // Seconds of motion checked per candidate move
+    const float PROJECTILE_RADIUS = 30.f;   // Center distance that counts as a hit, plus margin
+    const float ENEMY_RADIUS = 60.f;
+    const float ENEMY_FALL_SPEED = 160.f;   // Assumed enemy motion (paths mostly descend)
+    const float MAX_PROJECTILE_SPEED = 260.f;
+    const float FIRE_COLUMN = 24.f;         // Half-width of the column where shots can connect
+    const float HOME_Y = 480.f;
+
+    // Stay plus eight directions, as (dx, dy)
+    const int MOVES[9][2] = {
+        {0, 0}, {0, -1}, {0, 1}, {-1, 0}, {1, 0}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}
+    };
+
+    // Penetration depth of the closest approach during the lookahead window
+    float approachCost(sf::Vector2f offset, sf::Vector2f relativeVelocity, float radius) {
+        float vv = relativeVelocity.x * relativeVelocity.x + relativeVelocity.y * relativeVelocity.y;
+        float t = 0.f;
+        if (vv > 0.f) {
+            t = -(offset.x * relativeVelocity.x + offset.y * relativeVelocity.y) / vv;
+            t = std::min(std::max(t, 0.f), LOOKAHEAD);
+        }
+        sf::Vector2f closest = offset + relativeVelocity * t;
+        float distance = std::sqrt(closest.x * closest.x + closest.y * closest.y);
+        float depth = radius - distance;
+        // Earlier contact is worse than a near miss at the end of the window
+        return depth > 0.f ? depth * depth * (1.5f - t / LOOKAHEAD) : 0.f;
+    }
+}
+
+void AutopilotInput::DecisionStats::merge(const DecisionStats& other) {
+    decisions += other.decisions;
+    totalNs += other.totalNs;
+    maxNs = std::max(maxNs, other.maxNs);
+    threatsVisited += other.threatsVisited;
+}
+
+double AutopilotInput::DecisionStats::meanUs() const {
+    return decisions > 0 ? totalNs / 1000.0 / decisions : 0.0;
+}
+
+AutopilotInput::AutopilotInput()
+    : lastMove(0) {
+    threats.reserve(256);
+}
+
+PlayerInput AutopilotInput::nextInput(const Simulation& simulation) {
+    auto start = std::chrono::steady_clock::now();
+    PlayerInput input = decide(simulation);
+    std::uint64_t ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+
+    ++stats.decisions;
+    stats.totalNs += ns;
+    stats.maxNs = std::max(stats.maxNs, ns);
+    return input;
+}
+
+PlayerInput AutopilotInput::decide(const Simulation& simulation) {
+    sf::Vector2f player = simulation.getPlayer().getPosition();
+
+    // Gather nearby threats once; only grid cells and tree nodes within reach are visited
+    float reach = PLAYER_SPEED * LOOKAHEAD + MAX_PROJECTILE_SPEED * LOOKAHEAD + ENEMY_RADIUS;
+    sf::FloatRect area(player.x - reach, player.y - reach, 2.f * reach, 2.f * reach);
+    threats.clear();
+
+    simulation.getEnemyProjectiles().queryArea(area, [&](float x, float y, float vx, float vy) {
+        ++stats.threatsVisited;
+        if (std::fabs(x - player.x) < reach && std::fabs(y - player.y) < reach) {
+            threats.push_back(Threat{sf::Vector2f(x, y), sf::Vector2f(vx, vy), PROJECTILE_RADIUS});
+        }
+    });
+    simulation.queryEnemies(area, [&](const Enemy& enemy) {
+        ++stats.threatsVisited;
+        if (enemy.isActive()) {
+            threats.push_back(Threat{enemy.getPosition(), sf::Vector2f(0.f, ENEMY_FALL_SPEED), ENEMY_RADIUS});
+        }
+    });
+
+    // Target: the enemy above with the smallest horizontal offset, searched in a widening band
+    bool haveTarget = false;
+    float targetX = player.x;
+    for (float halfWidth = 100.f; !haveTarget && halfWidth <= Playfield::WIDTH; halfWidth *= 2.f) {
+        float bestDx = halfWidth;
+        sf::FloatRect band(player.x - halfWidth, 0.f, 2.f * halfWidth, player.y - 40.f);
+        simulation.queryEnemies(band, [&](const Enemy& enemy) {
+            ++stats.threatsVisited;
+            sf::Vector2f pos = enemy.getPosition();
+            float dx = std::fabs(pos.x - player.x);
+            if (enemy.isActive() && pos.y > 0.f && pos.y < player.y - 40.f && dx < bestDx) {
+                bestDx = dx;
+                targetX = pos.x;
+                haveTarget = true;
+            }
+        });
+    }
+
+    // Score every move: danger dominates, then lining up with the target, then staying home
+    int bestMove = 0;
+    float bestCost = 1e30f;
+    for (int m = 0; m < 9; ++m) {
+        sf::Vector2f direction(static_cast<float>(MOVES[m][0]), static_cast<float>(MOVES[m][1]));
+        if (MOVES[m][0] != 0 && MOVES[m][1] != 0) {
+            direction *= 0.7071f;
+        }
+        sf::Vector2f velocity = direction * PLAYER_SPEED;
+        sf::Vector2f end = player + velocity * LOOKAHEAD;
+
+        float cost = 0.f;
+        for (const Threat& threat : threats) {
+            cost += 10.f * approachCost(threat.position - player, threat.velocity - velocity, threat.radius);
+        }
+
+        // Walls pin the player in place, which the lookahead above doesn't model
+        if (end.x < 40.f || end.x > Playfield::WIDTH - 40.f || end.y < 200.f || end.y > Playfield::HEIGHT - 30.f) {
+            cost += 500.f;
+        }
+
+        float aimX = haveTarget ? targetX : Playfield::WIDTH / 2.f;
+        cost += std::fabs(end.x - aimX) + 0.5f * std::fabs(end.y - HOME_Y);
+
+        // Slight preference for the previous move avoids dithering between equal options
+        if (m == lastMove) {
+            cost -= 2.f;
+        }
+
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestMove = m;
+        }
+    }
+    lastMove = bestMove;
+
+    PlayerInput input;
+    input.left = MOVES[bestMove][0] < 0;
+    input.right = MOVES[bestMove][0] > 0;
+    input.up = MOVES[bestMove][1] < 0;
+    input.down = MOVES[bestMove][1] > 0;
+    input.fire = haveTarget && std::fabs(targetX - player.x) < FIRE_COLUMN;
+    return input;
+}
+
+const AutopilotInput::DecisionStats& AutopilotInput::getStats() const {
+    return stats;
+}
+
+void AutopilotInput::resetStats() {
+    stats = DecisionStats();
+}
@@ -1,5 +1,6 @@
 #include "Background.h"
 #include "ResourceManager.h"
+#include "Playfield.h"
 #include <random>
 
 Star::Star(float x, float y, float spd, const sf::Texture& texture) : speed(spd) {
@@ -19,24 +20,26 @@ void Star::update(float dt) {
     sprite.move(0.f, speed * dt);
     
     // Wrap around when off-screen
-    if (sprite.getPosition().y > 620.f) {
-        sprite.setPosition(sprite.getPosition().x, -20.f);
+    if (sprite.getPosition().y > Playfield::HEIGHT + Playfield::CULL_MARGIN) {
+        sprite.setPosition(sprite.getPosition().x, -Playfield::CULL_MARGIN);
     }
 }
 
-void Star::render(sf::RenderWindow& window) {
-    window.draw(sprite);
+void Star::render(RenderBackend& backend) {
+    backend.drawSprite(sprite);
 }
 
 // Background implementation
-Background::Background() : spawnTimer(0.f), spawnInterval(0.1f) {
+Background::Background() 
+    : spawnInterval(0.1f), starLimit(150), timers(nullptr), spawnTimer(TimingWheel::INVALID_TIMER), spawnTicks(1) {
+    stars.reserve(starLimit);
     const sf::Texture& texture = ResourceManager::getInstance().getTexture("star");
     
     // Create initial stars
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> posX(0.f, 800.f);
-    std::uniform_real_distribution<float> posY(0.f, 600.f);
+    std::uniform_real_distribution<float> posX(0.f, Playfield::WIDTH);
+    std::uniform_real_distribution<float> posY(0.f, Playfield::HEIGHT);
     std::uniform_real_distribution<float> speed(20.f, 100.f);
     
     for (int i = 0; i < 100; ++i) {
@@ -44,32 +47,48 @@ Background::Background() : spawnTimer(0.f), spawnInterval(0.1f) {
     }
 }
 
-void Background::update(float dt) {
-    for (auto& star : stars) {
-        star.update(dt);
+void Background::attach(TimingWheel& wheel, float tickLength) {
+    if (timers) {
+        timers->cancel(spawnTimer);
     }
-    
-    // Spawn new stars occasionally
-    spawnTimer += dt;
-    if (spawnTimer >= spawnInterval && stars.size() < 150) {
+    timers = &wheel;
+    spawnTicks = TimingWheel::toTicks(spawnInterval, tickLength);
+    spawnTimer = timers->schedule(spawnTicks, [this]() { spawnStar(); });
+}
+
+void Background::spawnStar() {
+    if (stars.size() < starLimit) {
         const sf::Texture& texture = ResourceManager::getInstance().getTexture("star");
         
         std::random_device rd;
         std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> posX(0.f, 800.f);
+        std::uniform_real_distribution<float> posX(0.f, Playfield::WIDTH);
         std::uniform_real_distribution<float> speed(20.f, 100.f);
         
         stars.emplace_back(posX(gen), -10.f, speed(gen), texture);
-        spawnTimer = 0.f;
     }
+    spawnTimer = timers->schedule(spawnTicks, [this]() { spawnStar(); });
 }
 
-void Background::render(sf::RenderWindow& window) {
+void Background::update(float dt) {
     for (auto& star : stars) {
-        star.render(window);
+        star.update(dt);
+    }
+}
+
+void Background::render(RenderBackend& backend) {
+    for (auto& star : stars) {
+        star.render(backend);
     }
 }
 
 void Background::clear() {
     stars.clear();
 }
+
+void Background::setStarLimit(std::size_t limit) {
+    starLimit = limit;
+    if (stars.size() > starLimit) {
+        stars.erase(stars.begin() + starLimit, stars.end());
+    }
+}
@@ -0,0 +1,1061 @@
+#include "Benchmarks.h"
+#include "Projectile.h"
+#include "MovementSystem.h"
+#include "SpatialIndex.h"
+#include "CollisionMask.h"
+#include "ResourceManager.h"
+#include "Simulation.h"
+#include "TimingWheel.h"
+#include "Level.h"
+#include "Audio.h"
+#include "InputSource.h"
+#include "SoftwareRenderer.h"
+#include "Playfield.h"
+#include "EngineMetrics.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace {
+    const float BENCH_TICK = 1.f / 120.f;
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Mean and 99th percentile of per-tick timings
+    void printTimings(const char* label, std::vector<double>& samples) {
+        double total = 0.0;
+        for (double s : samples) total += s;
+        std::sort(samples.begin(), samples.end());
+        double p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "  " << label << ": mean " << total / samples.size() << " ms"
+                  << ", p99 " << p99 << " ms" << std::endl;
+    }
+
+    // Resident set size of the process (Linux)
+    long residentKb() {
+        long pages = 0, resident = 0;
+        std::ifstream statm("/proc/self/statm");
+        statm >> pages >> resident;
+        return resident * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+}
+
+int runProjectileBenchmark(int projectileCount, int ticks) {
+    ProjectileSystem projectiles(static_cast<std::size_t>(projectileCount) + 4096);
+
+    // 64 fast spirals spread over the top half of the field
+    std::vector<BulletEmitter> emitters;
+    std::vector<sf::Vector2f> origins;
+    for (int i = 0; i < 64; ++i) {
+        origins.push_back(sf::Vector2f(50.f + (i % 16) * 46.f, 60.f + (i / 16) * 60.f));
+        emitters.push_back(BulletEmitter(BulletPattern::spiral(24, 7.f + i % 5, 60.f + (i % 7) * 10.f, 0.08f),
+                                         i * 0.001f));
+    }
+    sf::Vector2f player(400.f, 500.f);
+    sf::FloatRect playerBounds(384.f, 484.f, 32.f, 32.f);
+
+    // Fill up to the target count before measuring
+    int warmupTicks = 0;
+    while (projectiles.size() < static_cast<std::size_t>(projectileCount) && warmupTicks < 120 * 60) {
+        for (std::size_t e = 0; e < emitters.size(); ++e) {
+            emitters[e].update(BENCH_TICK, origins[e], player, projectiles);
+        }
+        projectiles.update(BENCH_TICK);
+        ++warmupTicks;
+    }
+
+    std::vector<double> tickTimes;
+    tickTimes.reserve(static_cast<std::size_t>(ticks));
+    std::size_t liveTotal = 0;
+    long hits = 0;
+
+    for (int t = 0; t < ticks; ++t) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Emitters only top up the population so the live count stays near the target
+        if (projectiles.size() < static_cast<std::size_t>(projectileCount)) {
+            for (std::size_t e = 0; e < emitters.size(); ++e) {
+                emitters[e].update(BENCH_TICK, origins[e], player, projectiles);
+            }
+        }
+        projectiles.update(BENCH_TICK);
+        hits += projectiles.collide(playerBounds);
+
+        tickTimes.push_back(elapsedMs(start));
+        liveTotal += projectiles.size();
+    }
+
+    double meanLive = static_cast<double>(liveTotal) / ticks;
+    double totalMs = 0.0;
+    for (double s : tickTimes) totalMs += s;
+
+    std::cout << "Projectile benchmark: " << ticks << " ticks at 120 Hz after " << warmupTicks << " warm-up ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(0)
+              << "  live projectiles: " << meanLive << " (target " << projectileCount << ")" << std::endl
+              << "  player hits: " << hits << std::endl;
+    printTimings("tick (emit + update + grid + collide)", tickTimes);
+    std::cout << std::setprecision(1)
+              << "  throughput: " << meanLive * ticks / (totalMs / 1000.0) / 1.0e6 << " M projectile-updates/s"
+              << std::endl;
+    return 0;
+}
+
+namespace {
+    // The pre-MovementSystem model: one heap object and virtual update per enemy
+    class VirtualMover {
+    public:
+        virtual ~VirtualMover() = default;
+        virtual void update(float dt) = 0;
+        virtual sf::Vector2f getPosition() const = 0;
+    };
+
+    class StraightMover : public VirtualMover {
+    private:
+        sf::Sprite sprite;
+        sf::Vector2f velocity;
+
+    public:
+        StraightMover(float x, float y, float speed) : velocity(0.f, speed) {
+            sprite.setPosition(x, y);
+        }
+
+        void update(float dt) override {
+            sprite.move(velocity * dt);
+        }
+
+        sf::Vector2f getPosition() const override {
+            return sprite.getPosition();
+        }
+    };
+
+    // Runs movement for a system whose movers were already added; returns ns per mover per tick
+    double timeMovementSystem(MovementSystem& movement, const std::vector<MoverHandle>& handles, int ticks, float& checksum) {
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; ++t) {
+            movement.update(BENCH_TICK);
+            checksum += movement.getPosition(handles[t % handles.size()]).y;
+        }
+        return elapsedMs(start) * 1.0e6 / (static_cast<double>(handles.size()) * ticks);
+    }
+}
+
+int runMovementBenchmark(int moverCount, int ticks) {
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<float> posX(50.f, 750.f);
+    std::uniform_real_distribution<float> scale(1.f, 3.f);
+    float checksum = 0.f;
+
+    // Baseline: virtual straight-line movers
+    std::vector<std::unique_ptr<VirtualMover>> legacy;
+    for (int i = 0; i < moverCount; ++i) {
+        legacy.push_back(std::make_unique<StraightMover>(posX(gen), -30.f, 100.f * scale(gen)));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        for (auto& mover : legacy) {
+            mover->update(BENCH_TICK);
+            checksum += mover->getPosition().y;
+        }
+    }
+    double legacyNs = elapsedMs(start) * 1.0e6 / (static_cast<double>(moverCount) * ticks);
+
+    // Batched, straight-line only
+    MovementSystem linear;
+    std::vector<MoverHandle> linearHandles;
+    for (int i = 0; i < moverCount; ++i) {
+        linearHandles.push_back(linear.add(0, posX(gen), -30.f, scale(gen)));
+    }
+    double linearNs = timeMovementSystem(linear, linearHandles, ticks, checksum);
+
+    // Batched, spread over every built-in path
+    MovementSystem mixed;
+    std::vector<MoverHandle> mixedHandles;
+    for (int i = 0; i < moverCount; ++i) {
+        mixedHandles.push_back(mixed.add(static_cast<std::size_t>(i) % mixed.getPathCount(), posX(gen), -30.f, scale(gen)));
+    }
+    double mixedNs = timeMovementSystem(mixed, mixedHandles, ticks, checksum);
+
+    std::cout << "Movement benchmark: " << moverCount << " movers, " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "  virtual straight-line: " << legacyNs << " ns/mover/tick" << std::endl
+              << "  batched straight-line: " << linearNs << " ns/mover/tick" << std::endl
+              << "  batched mixed (" << mixed.getPathCount() << " paths): " << mixedNs << " ns/mover/tick" << std::endl
+              << "  (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
+
+namespace {
+    class BenchEntity : public Entity {
+    public:
+        sf::Vector2f drift;
+
+        BenchEntity(float x, float y, sf::Vector2f v) : drift(v) {
+            initSprite(nullptr, 32.f, 32.f);
+            setPosition(x, y);
+        }
+
+        void update(float) override {}
+    };
+
+    double queriesPerSecond(int queries, double ms) {
+        return queries / (ms / 1000.0);
+    }
+}
+
+int runSpatialBenchmark(int entityCount, int ticks) {
+    // Field grows with the count so density matches a crowded screen (about 55 enemies on 800x600)
+    const float side = 80.f * std::sqrt(static_cast<float>(entityCount));
+    const float width = side * 4.f / 3.f;
+    const float height = side;
+    const int QUERIES_PER_TICK = 100;
+    const float LASER_LENGTH = 600.f;
+    const float SPLASH_RADIUS = 80.f;
+
+    std::mt19937 gen(4321);
+    std::uniform_real_distribution<float> posX(0.f, width);
+    std::uniform_real_distribution<float> posY(0.f, height);
+    std::uniform_real_distribution<float> vel(-150.f, 150.f);
+    std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+
+    std::vector<std::unique_ptr<BenchEntity>> entities;
+    for (int i = 0; i < entityCount; ++i) {
+        entities.push_back(std::make_unique<BenchEntity>(posX(gen), posY(gen), sf::Vector2f(vel(gen), vel(gen))));
+    }
+
+    SpatialIndex index;
+    std::vector<SpatialIndex::Proxy> proxies;
+    auto start = std::chrono::steady_clock::now();
+    for (auto& entity : entities) {
+        proxies.push_back(index.insert(*entity));
+    }
+    double buildMs = elapsedMs(start);
+
+    double updateMs = 0.0;
+    double treeMs[3] = {0.0, 0.0, 0.0};
+    double bruteMs[3] = {0.0, 0.0, 0.0};
+    long treeHits[3] = {0, 0, 0};
+    long bruteHits[3] = {0, 0, 0};
+    long reinserted = 0;
+    std::vector<RayHit> hits;
+    std::vector<sf::Vector2f> from(QUERIES_PER_TICK);
+    std::vector<sf::Vector2f> to(QUERIES_PER_TICK);
+
+    for (int t = 0; t < ticks; ++t) {
+        // Move everything (bouncing off the field edges) and update the index incrementally
+        start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < entities.size(); ++i) {
+            BenchEntity& e = *entities[i];
+            sf::Vector2f pos = e.getPosition();
+            if (pos.x < 0.f || pos.x > width) e.drift.x = -e.drift.x;
+            if (pos.y < 0.f || pos.y > height) e.drift.y = -e.drift.y;
+            sf::Vector2f step = e.drift * BENCH_TICK;
+            e.setPosition(pos + step);
+            if (index.update(proxies[i], step.x, step.y)) ++reinserted;
+        }
+        updateMs += elapsedMs(start);
+
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            float a = angle(gen);
+            from[q] = sf::Vector2f(posX(gen), posY(gen));
+            to[q] = from[q] + LASER_LENGTH * sf::Vector2f(std::cos(a), std::sin(a));
+        }
+
+        // Piercing laser: every entity along the segment
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            treeHits[0] += static_cast<long>(index.raycastAll(from[q], to[q], hits));
+        }
+        treeMs[0] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            float fraction;
+            for (auto& e : entities) {
+                if (SpatialIndex::segmentHitsBounds(from[q], to[q], e->getBounds(), fraction)) ++bruteHits[0];
+            }
+        }
+        bruteMs[0] += elapsedMs(start);
+
+        // Splash damage: everything within a radius
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            index.queryRadius(from[q], SPLASH_RADIUS, [&](const Entity&) { ++treeHits[1]; });
+        }
+        treeMs[1] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            for (auto& e : entities) {
+                if (Aabb::fromRect(e->getBounds()).distanceSquared(from[q].x, from[q].y) <= SPLASH_RADIUS * SPLASH_RADIUS) {
+                    ++bruteHits[1];
+                }
+            }
+        }
+        bruteMs[1] += elapsedMs(start);
+
+        // Homing: nearest entity; hits count matching distances between both methods
+        std::vector<float> nearestTree(QUERIES_PER_TICK);
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            const Entity* target = index.nearest(from[q], 1e9f, [](const Entity&) { return true; });
+            nearestTree[q] = target ? Aabb::fromRect(target->getBounds()).distanceSquared(from[q].x, from[q].y) : -1.f;
+        }
+        treeMs[2] += elapsedMs(start);
+        start = std::chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES_PER_TICK; ++q) {
+            float best = 1e18f;
+            for (auto& e : entities) {
+                best = std::min(best, Aabb::fromRect(e->getBounds()).distanceSquared(from[q].x, from[q].y));
+            }
+            ++bruteHits[2];
+            if (best == nearestTree[q]) ++treeHits[2];
+        }
+        bruteMs[2] += elapsedMs(start);
+    }
+
+    int queries = QUERIES_PER_TICK * ticks;
+    const char* names[3] = {"raycast (600 px laser)", "radius (80 px splash)", "nearest (homing)"};
+
+    std::cout << "Spatial query benchmark: " << entityCount << " moving entities on "
+              << static_cast<int>(width) << "x" << static_cast<int>(height) << ", " << ticks << " ticks, "
+              << queries << " queries per kind" << std::endl;
+    std::cout << std::fixed << std::setprecision(2)
+              << "  build: " << buildMs << " ms, tree height " << index.getTreeHeight() << std::endl
+              << "  incremental update: " << updateMs / ticks << " ms/tick, "
+              << std::setprecision(1) << 100.0 * reinserted / (static_cast<double>(entityCount) * ticks)
+              << "% of moves reinserted" << std::endl;
+    for (int k = 0; k < 3; ++k) {
+        std::cout << std::setprecision(0)
+                  << "  " << names[k] << ": tree " << queriesPerSecond(queries, treeMs[k]) << " q/s"
+                  << ", linear scan " << queriesPerSecond(queries, bruteMs[k]) << " q/s"
+                  << std::setprecision(1) << " (" << bruteMs[k] / treeMs[k] << "x)";
+        if (k < 2) {
+            std::cout << ", " << static_cast<double>(treeHits[k]) / queries << " hits/query"
+                      << (treeHits[k] == bruteHits[k] ? "" : " MISMATCH");
+        } else {
+            std::cout << (treeHits[k] == bruteHits[k] ? ", all match" : ", MISMATCH");
+        }
+        std::cout << std::endl;
+    }
+
+    bool ok = treeHits[0] == bruteHits[0] && treeHits[1] == bruteHits[1] && treeHits[2] == bruteHits[2];
+    return ok ? 0 : 1;
+}
+
+namespace {
+    // Per-pixel reference for the word-parallel test
+    bool pixelOverlap(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by) {
+        for (int y = 0; y < a.getHeight(); ++y) {
+            for (int x = 0; x < a.getWidth(); ++x) {
+                if (a.isSolid(x, y) && b.isSolid(x + ax - bx, y + ay - by)) return true;
+            }
+        }
+        return false;
+    }
+}
+
+int runMaskBenchmark(int pairCount) {
+    CollisionMask player = CollisionMask::fromImage(ResourceManager::createProceduralImage("player"));
+    CollisionMask enemy = CollisionMask::fromImage(ResourceManager::createProceduralImage("enemy"));
+    CollisionMask bullet = CollisionMask::fromImage(ResourceManager::createProceduralImage("bullet"));
+
+    // Offsets where the bounding boxes overlap, i.e. every pair reaching the narrow phase
+    struct Pair {
+        const CollisionMask* a;
+        const CollisionMask* b;
+        int dx;
+        int dy;
+    };
+    std::mt19937 gen(99);
+    std::vector<Pair> pairs;
+    for (int i = 0; i < pairCount; ++i) {
+        const CollisionMask* a = (i % 2 == 0) ? &player : &bullet;
+        std::uniform_int_distribution<int> dx(-enemy.getWidth() + 1, a->getWidth() - 1);
+        std::uniform_int_distribution<int> dy(-enemy.getHeight() + 1, a->getHeight() - 1);
+        pairs.push_back(Pair{a, &enemy, dx(gen), dy(gen)});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int hits = 0;
+    for (const Pair& p : pairs) {
+        if (CollisionMask::overlaps(*p.a, 0, 0, *p.b, p.dx, p.dy)) ++hits;
+    }
+    double maskMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    int referenceHits = 0;
+    int mismatches = 0;
+    for (const Pair& p : pairs) {
+        bool reference = pixelOverlap(*p.a, 0, 0, *p.b, p.dx, p.dy);
+        if (reference) ++referenceHits;
+        if (reference != CollisionMask::overlaps(*p.a, 0, 0, *p.b, p.dx, p.dy)) ++mismatches;
+    }
+    double referenceMs = elapsedMs(start) - maskMs;
+
+    std::cout << "Collision mask benchmark: " << pairCount << " AABB-overlapping pairs (player/bullet vs enemy)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "  solid pixels: player " << player.countSolid() << "/" << player.getWidth() * player.getHeight()
+              << ", enemy " << enemy.countSolid() << "/" << enemy.getWidth() * enemy.getHeight() << std::endl
+              << "  word test: " << pairCount / (maskMs / 1000.0) / 1.0e6 << " M tests/s ("
+              << std::setprecision(1) << maskMs * 1.0e6 / pairCount << " ns/test)" << std::endl
+              << "  per-pixel reference: " << pairCount / (referenceMs / 1000.0) / 1.0e6 << " M tests/s" << std::endl
+              << "  box overlaps that are real hits: " << 100.0 * hits / pairCount << "%"
+              << (mismatches == 0 ? ", matches reference" : ", MISMATCH") << std::endl;
+    return mismatches == 0 && hits == referenceHits ? 0 : 1;
+}
+
+int runCollisionBenchmark(int entityCount, int passes) {
+    CollisionMask enemyMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("enemy"));
+    CollisionMask bulletMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("bullet"));
+    SpriteMasks masks;
+    masks.enemy = &enemyMask;
+    masks.bullet = &bulletMask;
+
+    // Bullets and enemies scattered over a field scaled like the spatial benchmark
+    const float side = 80.f * std::sqrt(static_cast<float>(entityCount));
+    std::mt19937 gen(2468);
+    std::uniform_real_distribution<float> posX(0.f, side * 4.f / 3.f);
+    std::uniform_real_distribution<float> posY(0.f, side);
+
+    std::vector<Bullet> bullets;
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    for (int i = 0; i < entityCount; ++i) {
+        bullets.emplace_back(posX(gen), posY(gen), nullptr);
+        enemies.push_back(std::make_unique<Enemy>(posX(gen), posY(gen), MovementSystem::INVALID_MOVER, nullptr));
+    }
+
+    // Serial pass: the reference order
+    HitQueue serial;
+    CollisionStats serialStats;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        serial.clear();
+        serialStats = CollisionStats();
+        Simulation::detectBulletHits(bullets, 0, bullets.size(), enemies, masks, serial, serialStats);
+    }
+    double serialMs = elapsedMs(start) / passes;
+
+    // Parallel pass: one bullet range per thread, queues appended in range order
+    int threads = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<HitQueue> partial(threads);
+    std::vector<CollisionStats> partialStats(threads);
+    HitQueue merged;
+    CollisionStats mergedStats;
+    start = std::chrono::steady_clock::now();
+    for (int p = 0; p < passes; ++p) {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            std::size_t begin = bullets.size() * t / threads;
+            std::size_t end = bullets.size() * (t + 1) / threads;
+            workers.emplace_back([&, t, begin, end]() {
+                partial[t].clear();
+                partialStats[t] = CollisionStats();
+                Simulation::detectBulletHits(bullets, begin, end, enemies, masks, partial[t], partialStats[t]);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        merged.clear();
+        mergedStats = CollisionStats();
+        for (int t = 0; t < threads; ++t) {
+            merged.append(partial[t]);
+            mergedStats.merge(partialStats[t]);
+        }
+    }
+    double parallelMs = elapsedMs(start) / passes;
+
+    bool identical = merged.size() == serial.size() && mergedStats.maskTests == serialStats.maskTests;
+    for (std::size_t i = 0; identical && i < serial.size(); ++i) {
+        identical = merged[i] == serial[i];
+    }
+
+    double pairs = static_cast<double>(entityCount) * entityCount;
+    std::cout << "Collision detection benchmark: " << entityCount << " bullets x " << entityCount << " enemies, "
+              << passes << " passes" << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << "  serial: " << serialMs << " ms/pass (" << std::setprecision(1)
+              << pairs / (serialMs / 1000.0) / 1.0e6 << " M pairs/s)" << std::endl
+              << std::setprecision(3)
+              << "  " << threads << " threads: " << parallelMs << " ms/pass (" << std::setprecision(2)
+              << serialMs / parallelMs << "x, " << std::thread::hardware_concurrency() << " hardware threads)" << std::endl
+              << "  hits: " << serial.size() << " from " << serialStats.boxOverlaps << " box overlaps"
+              << (identical ? ", parallel queue identical to serial" : ", MISMATCH") << std::endl;
+    return identical ? 0 : 1;
+}
+
+int runTimerBenchmark(int timerCount, int ticks) {
+    // Cooldown-like timers of 0.1 to 5 seconds that re-arm when they fire
+    std::mt19937 gen(1357);
+    std::uniform_int_distribution<int> period(12, 600);
+    std::vector<int> periods(timerCount);
+    for (int& p : periods) {
+        p = period(gen);
+    }
+
+    // Polling: every countdown is decremented every tick
+    std::vector<int> remaining(periods);
+    long polledFires = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        for (int i = 0; i < timerCount; ++i) {
+            if (--remaining[i] == 0) {
+                remaining[i] = periods[i];
+                ++polledFires;
+            }
+        }
+    }
+    double pollMs = elapsedMs(start);
+
+    // Wheel: only timers due on a tick are touched
+    struct Repeat {
+        TimingWheel* wheel;
+        const int* period;
+        long* fires;
+        void operator()() const {
+            ++*fires;
+            wheel->schedule(static_cast<std::uint64_t>(*period), *this);
+        }
+    };
+    TimingWheel wheel;
+    wheel.reserve(static_cast<std::size_t>(timerCount));
+    long wheelFires = 0;
+    for (int i = 0; i < timerCount; ++i) {
+        wheel.schedule(static_cast<std::uint64_t>(periods[i]), Repeat{&wheel, &periods[i], &wheelFires});
+    }
+    start = std::chrono::steady_clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        wheel.advance();
+    }
+    double wheelMs = elapsedMs(start);
+
+    // Schedule and cancel pairs (buffs cut short, rescheduled spawns)
+    const int PAIRS = 1000000;
+    std::uniform_int_distribution<int> delay(1, 100000);
+    std::vector<std::uint64_t> delays(PAIRS);
+    for (auto& d : delays) {
+        d = static_cast<std::uint64_t>(delay(gen));
+    }
+    long cancelled = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PAIRS; ++i) {
+        TimingWheel::TimerId id = wheel.schedule(delays[i], []() {});
+        if (wheel.cancel(id)) ++cancelled;
+    }
+    double pairMs = elapsedMs(start);
+
+    std::cout << "Timer benchmark: " << timerCount << " repeating timers over " << ticks << " ticks" << std::endl;
+    std::cout << std::fixed << std::setprecision(3)
+              << "  polled countdowns: " << pollMs / ticks * 1000.0 << " us/tick" << std::endl
+              << "  timing wheel: " << wheelMs / ticks * 1000.0 << " us/tick ("
+              << std::setprecision(1) << pollMs / wheelMs << "x)" << std::endl
+              << "  fires: " << wheelFires << (wheelFires == polledFires ? ", same as polling" : ", MISMATCH") << std::endl
+              << "  schedule + cancel: " << pairMs * 1.0e6 / PAIRS << " ns/pair" << std::endl;
+    return wheelFires == polledFires && cancelled == PAIRS ? 0 : 1;
+}
+
+int runLevelBenchmark(int minutes) {
+    // A stress level: a spawn every tick, every tenth a five-ship formation
+    const char* file = "bench_level.lvl";
+    const std::uint64_t ticks = static_cast<std::uint64_t>(minutes) * 60 * 120;
+    LevelWriter writer;
+    writer.addPath("straight");
+    writer.addPath("weave");
+    std::vector<LevelFormat::FormationMember> vee = {
+        {0, 0, 0, 0}, {-40, -30, 6, 0}, {40, -30, 6, 0}, {-80, -60, 12, 0}, {80, -60, 12, 0}
+    };
+    writer.addFormation(vee);
+
+    auto start = std::chrono::steady_clock::now();
+    bool written = writer.begin(file);
+    for (std::uint64_t t = 0; t < ticks && written; ++t) {
+        LevelFormat::SpawnRecord record = {};
+        record.x = static_cast<std::int16_t>(100 + (t * 37) % 600);
+        record.path = static_cast<std::uint8_t>(t % 2);
+        record.formation = t % 10 == 0 ? 0 : LevelFormat::NO_FORMATION;
+        record.pattern = t % 3 == 0 ? static_cast<std::uint8_t>(t % LevelFormat::PATTERN_COUNT) : LevelFormat::NO_PATTERN;
+        record.speedTenths = 10;
+        record.fireDelayMs = 500;
+        written = writer.add(t, record);
+    }
+    written = writer.finish() && written;
+    double writeMs = elapsedMs(start);
+    if (!written) {
+        std::cerr << "Failed to write the benchmark level" << std::endl;
+        return 1;
+    }
+
+    std::ifstream sizeCheck(file, std::ios::binary | std::ios::ate);
+    double fileMb = static_cast<double>(sizeCheck.tellg()) / (1024.0 * 1024.0);
+
+    // Streamed: open, then poll every tick like the simulation does
+    long baseKb = residentKb();
+    start = std::chrono::steady_clock::now();
+    LevelStream stream;
+    if (!stream.open(file)) {
+        return 1;
+    }
+    std::vector<LevelSpawn> due;
+    due.reserve(64);
+    stream.poll(0, due);
+    double firstSpawnUs = elapsedMs(start) * 1000.0;
+
+    long streamedSpawns = 0;
+    double streamedSum = 0.0;
+    long peakKb = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::uint64_t t = 0; t <= ticks + 12; ++t) {
+        if (t > 0) {
+            due.clear();
+            stream.poll(t, due);
+        }
+        for (const LevelSpawn& spawn : due) {
+            ++streamedSpawns;
+            streamedSum += spawn.x + static_cast<double>(spawn.tick);
+        }
+        if (t % 1200 == 0) {
+            peakKb = std::max(peakKb, residentKb() - baseKb);
+        }
+    }
+    double streamMs = elapsedMs(start);
+    bool finished = stream.isFinished();
+    std::uint32_t records = stream.getRecordCount();
+    stream.close();
+
+    // Up front: whole file read and every spawn decoded before the first tick
+    baseKb = residentKb();
+    start = std::chrono::steady_clock::now();
+    std::ifstream in(file, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    LevelStream all;
+    std::vector<LevelSpawn> spawns;
+    if (all.open(file)) {
+        all.poll(ticks + 12, spawns);
+    }
+    double loadMs = elapsedMs(start);
+    long loadKb = residentKb() - baseKb;
+    double loadedSum = 0.0;
+    for (const LevelSpawn& spawn : spawns) {
+        loadedSum += spawn.x + static_cast<double>(spawn.tick);
+    }
+    std::remove(file);
+
+    bool match = finished && streamedSpawns == static_cast<long>(spawns.size()) && streamedSum == loadedSum;
+    std::cout << "Level benchmark: " << minutes << " min, " << records << " records, "
+              << std::fixed << std::setprecision(2) << fileMb << " MB (written in " << writeMs << " ms)" << std::endl;
+    std::cout << "  streamed: first spawn after " << firstSpawnUs << " us, "
+              << streamMs * 1.0e6 / static_cast<double>(ticks) << " ns/tick, resident growth peak " << peakKb << " KB" << std::endl;
+    std::cout << "  up front: first spawn after " << loadMs << " ms, resident growth " << loadKb << " KB" << std::endl;
+    std::cout << "  spawns: " << streamedSpawns << (match ? ", same as up front" : ", MISMATCH") << std::endl;
+    return match ? 0 : 1;
+}
+
+namespace {
+    struct AudioRun {
+        std::vector<double> frameMs;
+        AudioMixer::Stats stats;
+    };
+
+    // Mixes seconds of audio in 60 Hz frames, triggering sounds at random field positions
+    AudioRun runAudioScene(AudioMixer& mixer, int triggersPerSecond, int seconds) {
+        const float frameTime = 1.f / 60.f;
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> x(0.f, 800.f);
+        std::uniform_real_distribution<float> y(0.f, 600.f);
+        std::uniform_int_distribution<int> kind(0, 99);
+
+        mixer.createSounds();
+        mixer.setListener(400.f, 550.f);
+        NullAudioBackend backend;
+        backend.start(mixer);
+
+        AudioRun run;
+        run.frameMs.reserve(seconds * 60);
+        double due = 0.0;
+        for (int frame = 0; frame < seconds * 60; ++frame) {
+            // Half enemy shots, then player shots, explosions and the odd hit
+            for (due += triggersPerSecond / 60.0; due >= 1.0; due -= 1.0) {
+                int k = kind(rng);
+                SoundId sound = k < 50 ? SoundId::ENEMY_SHOT : k < 70 ? SoundId::PLAYER_SHOT
+                              : k < 95 ? SoundId::EXPLOSION : SoundId::PLAYER_HIT;
+                mixer.play(sound, x(rng), y(rng));
+            }
+            auto start = std::chrono::steady_clock::now();
+            backend.update(frameTime);
+            run.frameMs.push_back(elapsedMs(start));
+        }
+        backend.stop();
+        run.stats = mixer.getStats();
+        return run;
+    }
+}
+
+int runAudioBenchmark(int triggersPerSecond) {
+    const int SECONDS = 60;
+
+    // Unpooled: enough voices that every audible trigger gets its own (explosions last 0.9 s)
+    AudioMixer pooled;
+    AudioMixer unpooled(static_cast<std::size_t>(triggersPerSecond) + 64);
+    unpooled.setInstanceLimits(false);
+    AudioRun pool = runAudioScene(pooled, triggersPerSecond, SECONDS);
+    AudioRun each = runAudioScene(unpooled, triggersPerSecond, SECONDS);
+
+    std::cout << "Audio benchmark: " << triggersPerSecond << " triggers/s for " << SECONDS
+              << " s, offline mixing in 60 Hz frames" << std::endl;
+    std::cout << "  pooled (" << pooled.getVoiceCount() << " voices): peak " << pool.stats.peakVoices << " voices, "
+              << pool.stats.played << " played, " << pool.stats.stolen << " stolen, " << pool.stats.culled << " culled" << std::endl;
+    printTimings("pooled mix per frame", pool.frameMs);
+    std::cout << "  voice per trigger: peak " << each.stats.peakVoices << " voices, "
+              << each.stats.played << " played, " << each.stats.culled << " culled" << std::endl;
+    printTimings("voice per trigger mix per frame", each.frameMs);
+    std::cout.unsetf(std::ios::fixed);
+
+    // Every audible trigger was either played, stolen into a voice or culled by priority
+    bool accounted = pool.stats.played + pool.stats.stolen + pool.stats.culled + pool.stats.dropped == pool.stats.requests;
+    bool bounded = pool.stats.peakVoices <= static_cast<int>(pooled.getVoiceCount());
+    return accounted && bounded ? 0 : 1;
+}
+
+namespace {
+    struct DeterminismRun {
+        double ms = 0.0;
+        std::uint64_t ticks = 0;
+        long long score = 0;
+        std::uint64_t hash = 0;     // Session end states folded in session order
+    };
+
+    // With metrics, each tick is also published the way the game does it (as if every tick were a frame)
+    DeterminismRun runScriptedSessions(const SimulationConfig& config, int sessions, int maxTicks,
+                                       EngineMetrics* metrics = nullptr) {
+        Simulation simulation(config);
+        DeterminismRun run;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < sessions; ++i) {
+            std::uint32_t seed = 1 + static_cast<std::uint32_t>(i);
+            simulation.reset(seed);
+            ScriptedInput input(seed * 2654435761u);
+            if (metrics) metrics->startSession();
+            while (!simulation.isOver() && simulation.getTick() < static_cast<std::uint64_t>(maxTicks)) {
+                simulation.step(input.nextInput(simulation));
+                if (metrics) {
+                    metrics->recordTick(simulation);
+                    metrics->recordFrame(BENCH_TICK, &simulation, 0);
+                }
+            }
+            if (metrics) metrics->endSession(simulation.getScore());
+            run.ticks += simulation.getTick();
+            run.score += simulation.getScore();
+            run.hash = (run.hash ^ simulation.getStateHash()) * 1099511628211ull;
+        }
+        run.ms = elapsedMs(start);
+        return run;
+    }
+}
+
+int runFixedPointBenchmark(int sessions) {
+    const int MAX_TICKS = 120 * 60;
+
+    // Same setup as the batch runner: path file and pixel masks, no textures
+    SimulationConfig config;
+    MovementSystem::readPathFile("assets/paths.txt", config.paths);
+    CollisionMask playerMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("player"));
+    CollisionMask enemyMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("enemy"));
+    CollisionMask bulletMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("bullet"));
+    config.masks.player = &playerMask;
+    config.masks.enemy = &enemyMask;
+    config.masks.bullet = &bulletMask;
+
+    SimulationConfig fixedConfig = config;
+    fixedConfig.fixedPoint = true;
+
+    DeterminismRun floating = runScriptedSessions(config, sessions, MAX_TICKS);
+    DeterminismRun fixed = runScriptedSessions(fixedConfig, sessions, MAX_TICKS);
+    DeterminismRun replay = runScriptedSessions(fixedConfig, sessions, MAX_TICKS);
+
+    auto print = [](const char* label, const DeterminismRun& run, int count) {
+        std::cout << "  " << label << ": " << std::setprecision(0) << run.ticks / (run.ms / 1000.0) << " ticks/s, "
+                  << std::setprecision(3) << run.ms * 1000.0 / static_cast<double>(run.ticks) << " us/tick, mean score "
+                  << std::setprecision(1) << static_cast<double>(run.score) / count
+                  << ", state hash " << std::hex << std::setw(16) << std::setfill('0') << run.hash
+                  << std::dec << std::setfill(' ') << std::endl;
+    };
+
+    std::cout << "Fixed-point benchmark: " << sessions << " scripted sessions of up to " << MAX_TICKS << " ticks" << std::endl;
+    std::cout << std::fixed;
+    print("float", floating, sessions);
+    print("fixed", fixed, sessions);
+    std::cout << std::setprecision(1) << "  fixed-point cost: " << (fixed.ms / fixed.ticks) / (floating.ms / floating.ticks) * 100.0 - 100.0
+              << "% per tick; replay " << (replay.hash == fixed.hash ? "identical" : "DIFFERS") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+
+    // Difficulty past the scores sessions reach, up to where Q16.16 scores overflow and beyond:
+    // it must keep rising to the cap and never wrap
+    const int SCORES[] = { 0, 200, 12600, 32767, 32768, 65536, 1000000, std::numeric_limits<int>::max() };
+    bool difficultyOk = true;
+    Fixed previous = Fixed::fromInt(0);
+    for (int score : SCORES) {
+        Fixed level = Simulation::fixedDifficultyFor(score);
+        if (level < previous || level < Fixed::fromInt(1) || level > Fixed::fromInt(Simulation::MAX_FIXED_DIFFICULTY)) {
+            std::cout << "  difficulty at score " << score << " is " << level.toFloat() << std::endl;
+            difficultyOk = false;
+        }
+        previous = level;
+    }
+    std::cout << "  difficulty up to score " << std::numeric_limits<int>::max() << ": "
+              << (difficultyOk ? "capped" : "OUT OF RANGE") << " at " << Simulation::MAX_FIXED_DIFFICULTY << std::endl;
+
+    return replay.hash == fixed.hash && difficultyOk ? 0 : 1;
+}
+
+namespace {
+    // A busy world frame: stars, then ships, bullets and fading particles, then a projectile batch
+    const char* const SCENE_TEXTURES[4] = {"star", "enemy", "bullet", "particle"};
+
+    struct RenderScene {
+        sf::Texture textures[4];            // Never uploaded; they only identify the CPU copies
+        sf::Image images[4];
+        std::vector<sf::Sprite> sprites;
+        std::vector<sf::Vector2f> velocities;
+        std::vector<sf::Vertex> projectiles;
+        std::size_t projectileCount = 0;
+    };
+
+    void buildRenderScene(RenderScene& scene, int spriteCount) {
+        for (int t = 0; t < 4; ++t) {
+            scene.images[t] = ResourceManager::createProceduralImage(SCENE_TEXTURES[t]);
+        }
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> x(0.f, Playfield::WIDTH);
+        std::uniform_real_distribution<float> y(0.f, Playfield::HEIGHT);
+        std::uniform_real_distribution<float> v(-120.f, 120.f);
+        for (int i = 0; i < 150 + spriteCount; ++i) {
+            int kind = i < 150 ? 0 : 1 + (i % 10) / 4;          // 40% ships, 40% bullets, 20% particles
+            sf::Vector2u size = scene.images[kind].getSize();
+            sf::Sprite sprite;
+            sprite.setTexture(scene.textures[kind]);
+            sprite.setTextureRect(sf::IntRect(0, 0, static_cast<int>(size.x), static_cast<int>(size.y)));
+            sprite.setOrigin(size.x / 2.f, size.y / 2.f);
+            sprite.setPosition(x(rng), y(rng));
+            if (kind == 0) {
+                sf::Uint8 bright = static_cast<sf::Uint8>(100 + i % 156);
+                sprite.setColor(sf::Color(bright, bright, bright));
+            } else if (kind == 3) {
+                sprite.setScale(2.f, 2.f);
+                sprite.setColor(sf::Color(255, 255, 255, static_cast<sf::Uint8>(40 + (i * 37) % 215)));
+            }
+            scene.sprites.push_back(sprite);
+            scene.velocities.push_back(sf::Vector2f(v(rng), v(rng)));
+        }
+        scene.projectileCount = static_cast<std::size_t>(spriteCount / 2);
+        scene.projectiles.resize(scene.projectileCount * 4);
+    }
+
+    // Positions are a function of the frame, so every run draws the same frames
+    void drawRenderScene(RenderScene& scene, int frame, RenderBackend& backend) {
+        const float t = frame / 60.f;
+        auto wrap = [](float value, float size) { return std::fmod(std::fmod(value, size + 64.f) + size + 64.f, size + 64.f) - 32.f; };
+        for (std::size_t i = 0; i < scene.sprites.size(); ++i) {
+            sf::Sprite sprite = scene.sprites[i];
+            sf::Vector2f start = sprite.getPosition();
+            sprite.setPosition(wrap(start.x + scene.velocities[i].x * t, Playfield::WIDTH),
+                               wrap(start.y + scene.velocities[i].y * t, Playfield::HEIGHT));
+            backend.drawSprite(sprite);
+        }
+
+        const sf::Color color(255, 120, 200);
+        for (std::size_t i = 0; i < scene.projectileCount; ++i) {
+            float x = wrap(i * 53.f + 90.f * t, Playfield::WIDTH);
+            float y = wrap(i * 31.f + 140.f * t, Playfield::HEIGHT);
+            sf::Vertex* quad = &scene.projectiles[i * 4];
+            quad[0] = sf::Vertex(sf::Vector2f(x - 3.f, y - 3.f), color);
+            quad[1] = sf::Vertex(sf::Vector2f(x + 3.f, y - 3.f), color);
+            quad[2] = sf::Vertex(sf::Vector2f(x + 3.f, y + 3.f), color);
+            quad[3] = sf::Vertex(sf::Vector2f(x - 3.f, y + 3.f), color);
+        }
+        backend.drawQuads(scene.projectiles.data(), scene.projectiles.size(), nullptr);
+    }
+
+    struct RenderRun {
+        std::vector<double> frameMs;        // Recording plus rasterization
+        std::uint64_t pixels = 0;
+        std::uint64_t checksum = 0;         // Every frame's image folded in order
+    };
+
+    RenderRun runRenderScene(RenderScene& scene, SoftwareRenderer& renderer, int frames) {
+        RenderRun run;
+        run.frameMs.reserve(static_cast<std::size_t>(frames));
+        std::uint64_t pixelsBefore = renderer.getStats().pixels;
+        for (int frame = 0; frame < frames; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+            renderer.clear(sf::Color(10, 10, 30));
+            drawRenderScene(scene, frame, renderer);
+            renderer.finish();
+            run.frameMs.push_back(elapsedMs(start));
+            run.checksum = (run.checksum ^ renderer.checksum()) * 1099511628211ull;
+        }
+        run.pixels = renderer.getStats().pixels - pixelsBefore;
+        return run;
+    }
+}
+
+int runRenderBenchmark(int spriteCount, int frames) {
+    // Field at the highest render scale
+    const unsigned int width = static_cast<unsigned int>(Playfield::WIDTH * 2.f);
+    const unsigned int height = static_cast<unsigned int>(Playfield::HEIGHT * 2.f);
+    const int threads = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+
+    RenderScene scene;
+    buildRenderScene(scene, spriteCount);
+    SoftwareRenderer single(width, height, 1);
+    SoftwareRenderer parallel(width, height, threads);
+    for (SoftwareRenderer* renderer : {&single, &parallel}) {
+        renderer->setView(Playfield::bounds());
+        for (int t = 0; t < 4; ++t) {
+            renderer->addTexture(&scene.textures[t], scene.images[t]);
+        }
+    }
+
+    single.setSimd(false);
+    RenderRun scalar = runRenderScene(scene, single, frames);
+    single.setSimd(true);
+    RenderRun simd = runRenderScene(scene, single, frames);
+    RenderRun tiled = runRenderScene(scene, parallel, frames);
+
+    auto throughput = [](const RenderRun& run) {
+        double ms = 0.0;
+        for (double f : run.frameMs) ms += f;
+        return run.pixels / (ms * 1000.0);
+    };
+
+    std::cout << "Render benchmark: " << scene.sprites.size() << " sprites and " << scene.projectileCount
+              << " projectile quads per frame, " << width << "x" << height << ", " << frames << " frames"
+              << (single.isSimdAvailable() ? "" : " (no SSE2: the SIMD runs are scalar)") << std::endl;
+    printTimings("scalar, 1 thread", scalar.frameMs);
+    printTimings("SIMD, 1 thread", simd.frameMs);
+    std::string label = "SIMD, " + std::to_string(threads) + " threads";
+    printTimings(label.c_str(), tiled.frameMs);
+    std::cout << std::setprecision(1) << "  fill rate: " << throughput(scalar) << " / " << throughput(simd)
+              << " / " << throughput(tiled) << " Mpixels/s" << std::endl;
+
+    bool match = scalar.checksum == simd.checksum && simd.checksum == tiled.checksum;
+    std::cout << "  image checksum " << std::hex << std::setw(16) << std::setfill('0') << tiled.checksum
+              << std::dec << std::setfill(' ') << (match ? ", identical in all runs" : ", MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    return match ? 0 : 1;
+}
+
+namespace {
+    // One GET /metrics over loopback; returns the whole response (empty on failure)
+    std::string scrapeMetrics(int port) {
+        std::string response;
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return response;
+
+        sockaddr_in server = {};
+        server.sin_family = AF_INET;
+        server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        server.sin_port = htons(static_cast<std::uint16_t>(port));
+        const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&server), sizeof(server)) == 0
+            && ::send(fd, request, sizeof(request) - 1, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(request) - 1)) {
+            char buffer[4096];
+            ssize_t n;
+            while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+                response.append(buffer, static_cast<std::size_t>(n));
+            }
+        }
+        ::close(fd);
+        return response;
+    }
+}
+
+int runMetricsBenchmark(int sessions) {
+    const int MAX_TICKS = 120 * 60;
+    const auto SCRAPE_INTERVAL = std::chrono::milliseconds(10);
+
+    SimulationConfig config;
+    MovementSystem::readPathFile("assets/paths.txt", config.paths);
+    CollisionMask playerMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("player"));
+    CollisionMask enemyMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("enemy"));
+    CollisionMask bulletMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("bullet"));
+    config.masks.player = &playerMask;
+    config.masks.enemy = &enemyMask;
+    config.masks.bullet = &bulletMask;
+
+    EngineMetrics metrics;
+    MetricsServer server(metrics.registry);
+    if (!server.start("0")) {
+        return 1;
+    }
+
+    DeterminismRun plain = runScriptedSessions(config, sessions, MAX_TICKS);
+    DeterminismRun published = runScriptedSessions(config, sessions, MAX_TICKS, &metrics);
+
+    // Again while a scraper polls the endpoint every 10 ms (Prometheus defaults to 15 s)
+    std::atomic<bool> scraping(true);
+    std::vector<double> scrapeMs;
+    std::size_t responseBytes = 0;
+    bool valid = true;
+    std::thread scraper([&]() {
+        while (scraping) {
+            auto start = std::chrono::steady_clock::now();
+            std::string response = scrapeMetrics(server.getPort());
+            scrapeMs.push_back(elapsedMs(start));
+            responseBytes = response.size();
+            valid = valid && response.compare(0, 15, "HTTP/1.0 200 OK") == 0
+                    && response.find("spaceshooter_ticks_total ") != std::string::npos;
+            std::this_thread::sleep_until(start + SCRAPE_INTERVAL);
+        }
+    });
+    DeterminismRun scraped = runScriptedSessions(config, sessions, MAX_TICKS, &metrics);
+    scraping = false;
+    scraper.join();
+    server.stop();
+
+    std::cout << "Metrics benchmark: " << sessions << " scripted sessions of up to " << MAX_TICKS
+              << " ticks, every tick published as a frame" << std::endl;
+    std::cout << std::fixed;
+    auto print = [](const char* label, const DeterminismRun& run) {
+        std::cout << "  " << label << ": " << std::setprecision(3) << run.ms * 1000.0 / static_cast<double>(run.ticks)
+                  << " us/tick" << std::endl;
+    };
+    print("no metrics", plain);
+    print("metrics", published);
+    print("metrics, scraped", scraped);
+    std::cout << std::setprecision(1) << "  publishing cost: "
+              << (published.ms / published.ticks) / (plain.ms / plain.ticks) * 100.0 - 100.0 << "% per tick, "
+              << (scraped.ms / scraped.ticks) / (plain.ms / plain.ticks) * 100.0 - 100.0 << "% while scraped" << std::endl;
+
+    bool anyScrapes = !scrapeMs.empty();
+    if (anyScrapes) {
+        printTimings("scrape", scrapeMs);
+        std::cout << "  " << server.getScrapes() << " scrapes of " << responseBytes << " bytes" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+
+    // Publishing only reads the simulation
+    bool unchanged = published.hash == plain.hash && scraped.hash == plain.hash;
+    std::cout << "  state hashes " << (unchanged ? "identical" : "DIFFER") << ", responses "
+              << (valid && anyScrapes ? "valid" : "INVALID") << std::endl;
+    return unchanged && valid && anyScrapes ? 0 : 1;
+}
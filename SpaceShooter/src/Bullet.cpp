@@ -1,24 +1,32 @@
 #include "Bullet.h"
-#include "ResourceManager.h"
+#include "Playfield.h"
 
-Bullet::Bullet(float x, float y) {
+Bullet::Bullet(float x, float y, const sf::Texture* texture) {
     speed = 500.f;
-    setTexture(ResourceManager::getInstance().getTexture("bullet"));
-    
-    // Center the origin
-    sf::FloatRect bounds = sprite.getLocalBounds();
-    sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+    initSprite(texture, 8.f, 16.f);
     
     setPosition(x, y);
     velocity.y = -speed;
 }
 
+void Bullet::initFixed(const FixedVec2& pos, int ticksPerSecond) {
+    fixedVelocity = FixedVec2(Fixed(), -Fixed::fromFloat(speed) / ticksPerSecond);
+    setFixedPosition(pos);
+}
+
+void Bullet::updateFixed() {
+    setFixedPosition(FixedVec2(fixedPosition.x, fixedPosition.y + fixedVelocity.y));
+    if (fixedPosition.y < -Fixed::fromFloat(Playfield::CULL_MARGIN)) {
+        active = false;
+    }
+}
+
 void Bullet::update(float dt) {
     // Move upward
     sprite.move(velocity * dt);
     
-    // Deactivate if off-screen
-    if (sprite.getPosition().y < -20.f) {
+    // Deactivate once above the field
+    if (sprite.getPosition().y < -Playfield::CULL_MARGIN) {
         active = false;
     }
 }
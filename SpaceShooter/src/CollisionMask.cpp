@@ -0,0 +1,127 @@
+#include "CollisionMask.h"
+#include <algorithm>
+
+void CollisionStats::merge(const CollisionStats& other) {
+    boxOverlaps += other.boxOverlaps;
+    maskTests += other.maskTests;
+    maskRejects += other.maskRejects;
+}
+
+CollisionMask::CollisionMask()
+    : width(0)
+    , height(0)
+    , wordsPerRow(0) {}
+
+CollisionMask::CollisionMask(int w, int h)
+    : width(std::max(w, 0))
+    , height(std::max(h, 0))
+    , wordsPerRow((std::max(w, 0) + 63) / 64)
+    , bits(static_cast<std::size_t>(wordsPerRow) * static_cast<std::size_t>(height), 0) {}
+
+CollisionMask CollisionMask::fromImage(const sf::Image& image, std::uint8_t alphaThreshold) {
+    sf::Vector2u size = image.getSize();
+    CollisionMask mask(static_cast<int>(size.x), static_cast<int>(size.y));
+
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    for (unsigned int y = 0; y < size.y; ++y) {
+        for (unsigned int x = 0; x < size.x; ++x) {
+            if (pixels[(static_cast<std::size_t>(y) * size.x + x) * 4 + 3] >= alphaThreshold) {
+                mask.setSolid(static_cast<int>(x), static_cast<int>(y), true);
+            }
+        }
+    }
+    return mask;
+}
+
+CollisionMask CollisionMask::filled(int w, int h) {
+    CollisionMask mask(w, h);
+    for (int y = 0; y < mask.height; ++y) {
+        for (int x = 0; x < mask.width; ++x) {
+            mask.setSolid(x, y, true);
+        }
+    }
+    return mask;
+}
+
+int CollisionMask::getWidth() const {
+    return width;
+}
+
+int CollisionMask::getHeight() const {
+    return height;
+}
+
+bool CollisionMask::isSolid(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+    return (bits[static_cast<std::size_t>(y * wordsPerRow + x / 64)] >> (x % 64)) & 1u;
+}
+
+void CollisionMask::setSolid(int x, int y, bool solid) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+    std::uint64_t& word = bits[static_cast<std::size_t>(y * wordsPerRow + x / 64)];
+    std::uint64_t bit = std::uint64_t(1) << (x % 64);
+    word = solid ? (word | bit) : (word & ~bit);
+}
+
+std::size_t CollisionMask::countSolid() const {
+    std::size_t count = 0;
+    for (std::uint64_t word : bits) {
+        count += static_cast<std::size_t>(__builtin_popcountll(word));
+    }
+    return count;
+}
+
+bool CollisionMask::overlaps(const CollisionMask& a, int ax, int ay, const CollisionMask& b, int bx, int by) {
+    // Overlap rectangle in a's coordinates
+    int x0 = std::max(0, bx - ax);
+    int x1 = std::min(a.width, bx - ax + b.width);
+    int y0 = std::max(0, by - ay);
+    int y1 = std::min(a.height, by - ay + b.height);
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    // b's bits are fetched aligned to a's words; bits past either mask's edge are zero.
+    // The word index and shift into b only depend on the column, so rows just AND.
+    int offsetY = ay - by;
+    for (int w = x0 / 64; w <= (x1 - 1) / 64; ++w) {
+        int bx0 = w * 64 + ax - bx;
+        int word = bx0 >= 0 ? bx0 / 64 : -((63 - bx0) / 64);   // Floor division
+        int shift = bx0 - word * 64;
+        bool haveLow = word >= 0 && word < b.wordsPerRow;
+        bool haveHigh = shift != 0 && word + 1 >= 0 && word + 1 < b.wordsPerRow;
+
+        const std::uint64_t* rowA = &a.bits[static_cast<std::size_t>(y0 * a.wordsPerRow + w)];
+        const std::uint64_t* rowB = &b.bits[static_cast<std::size_t>((y0 + offsetY) * b.wordsPerRow)];
+        std::uint64_t any = 0;
+        for (int y = y0; y < y1; ++y) {
+            std::uint64_t low = haveLow ? rowB[word] >> shift : 0;
+            std::uint64_t high = haveHigh ? rowB[word + 1] << (64 - shift) : 0;
+            any |= *rowA & (low | high);
+            rowA += a.wordsPerRow;
+            rowB += b.wordsPerRow;
+        }
+        if (any) return true;
+    }
+    return false;
+}
+
+bool CollisionMask::overlapsRect(int x, int y, int w, int h) const {
+    int x0 = std::max(0, x);
+    int x1 = std::min(width, x + w);
+    int y0 = std::max(0, y);
+    int y1 = std::min(height, y + h);
+    if (x0 >= x1 || y0 >= y1) return false;
+
+    for (int row = y0; row < y1; ++row) {
+        for (int word = x0 / 64; word <= (x1 - 1) / 64; ++word) {
+            // Bits of this word that fall inside [x0, x1)
+            int lo = std::max(x0 - word * 64, 0);
+            int hi = std::min(x1 - word * 64, 64);
+            std::uint64_t span = (hi == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << hi) - 1)
+                               & ~((std::uint64_t(1) << lo) - 1);
+            if (bits[static_cast<std::size_t>(row * wordsPerRow + word)] & span) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,152 @@
+#include "Compression.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+    const std::size_t MIN_MATCH = 4;
+    const std::size_t LAST_LITERALS = 5;   // Block must end with at least 5 literals
+    const std::size_t MATCH_LIMIT = 12;    // Last match must start 12 bytes before the end
+    const std::size_t MAX_OFFSET = 65535;
+    const int HASH_BITS = 12;
+    const std::size_t NO_POSITION = static_cast<std::size_t>(-1);
+
+    std::uint32_t read32(const std::uint8_t* p) {
+        std::uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    std::uint32_t hashSequence(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Writes the 255-run length extension used for literal and match lengths
+    bool writeLength(std::size_t length, std::uint8_t* dst, std::size_t& op, std::size_t capacity) {
+        while (length >= 255) {
+            if (op >= capacity) return false;
+            dst[op++] = 255;
+            length -= 255;
+        }
+        if (op >= capacity) return false;
+        dst[op++] = static_cast<std::uint8_t>(length);
+        return true;
+    }
+
+    bool readLength(const std::uint8_t* src, std::size_t& ip, std::size_t srcSize, std::size_t& length) {
+        std::uint8_t b;
+        do {
+            if (ip >= srcSize) return false;
+            b = src[ip++];
+            length += b;
+        } while (b == 255);
+        return true;
+    }
+}
+
+std::size_t lz4CompressBound(std::size_t srcSize) {
+    return srcSize + srcSize / 255 + 16;
+}
+
+std::size_t lz4Compress(const std::uint8_t* src, std::size_t srcSize,
+                        std::uint8_t* dst, std::size_t dstCapacity) {
+    std::vector<std::size_t> table(std::size_t(1) << HASH_BITS, NO_POSITION);
+    std::size_t ip = 0;
+    std::size_t anchor = 0;
+    std::size_t op = 0;
+
+    // Emits pending literals followed by an optional match (matchLength 0 = last sequence)
+    auto emitSequence = [&](std::size_t literalEnd, std::size_t offset, std::size_t matchLength) {
+        std::size_t literalLength = literalEnd - anchor;
+        std::size_t tokenPos = op;
+        if (op >= dstCapacity) return false;
+        ++op;
+
+        std::uint8_t token = static_cast<std::uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+        if (literalLength >= 15 && !writeLength(literalLength - 15, dst, op, dstCapacity)) return false;
+
+        if (op + literalLength > dstCapacity) return false;
+        std::memcpy(dst + op, src + anchor, literalLength);
+        op += literalLength;
+
+        if (matchLength > 0) {
+            if (op + 2 > dstCapacity) return false;
+            dst[op++] = static_cast<std::uint8_t>(offset & 0xFF);
+            dst[op++] = static_cast<std::uint8_t>(offset >> 8);
+
+            std::size_t code = matchLength - MIN_MATCH;
+            token |= static_cast<std::uint8_t>(code >= 15 ? 15 : code);
+            if (code >= 15 && !writeLength(code - 15, dst, op, dstCapacity)) return false;
+        }
+
+        dst[tokenPos] = token;
+        return true;
+    };
+
+    if (srcSize > MATCH_LIMIT) {
+        std::size_t limit = srcSize - MATCH_LIMIT;
+        while (ip < limit) {
+            std::uint32_t sequence = read32(src + ip);
+            std::uint32_t h = hashSequence(sequence);
+            std::size_t ref = table[h];
+            table[h] = ip;
+
+            if (ref == NO_POSITION || ip - ref > MAX_OFFSET || read32(src + ref) != sequence) {
+                ++ip;
+                continue;
+            }
+
+            // Extend the match as far as the trailing-literal rule allows
+            std::size_t maxLength = srcSize - LAST_LITERALS - ip;
+            std::size_t matchLength = MIN_MATCH;
+            while (matchLength < maxLength && src[ref + matchLength] == src[ip + matchLength]) {
+                ++matchLength;
+            }
+
+            if (!emitSequence(ip, ip - ref, matchLength)) return 0;
+            ip += matchLength;
+            anchor = ip;
+        }
+    }
+
+    if (!emitSequence(srcSize, 0, 0)) return 0;
+    return op;
+}
+
+bool lz4Decompress(const std::uint8_t* src, std::size_t srcSize,
+                   std::uint8_t* dst, std::size_t dstSize) {
+    std::size_t ip = 0;
+    std::size_t op = 0;
+
+    while (ip < srcSize) {
+        std::uint8_t token = src[ip++];
+
+        std::size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(src, ip, srcSize, literalLength)) return false;
+        if (ip + literalLength > srcSize || op + literalLength > dstSize) return false;
+        std::memcpy(dst + op, src + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        // The last sequence carries literals only
+        if (ip == srcSize) break;
+
+        if (ip + 2 > srcSize) return false;
+        std::size_t offset = src[ip] | (static_cast<std::size_t>(src[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return false;
+
+        std::size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(src, ip, srcSize, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (op + matchLength > dstSize) return false;
+
+        // Byte copy: source and destination may overlap for repeating runs
+        const std::uint8_t* match = dst + op - offset;
+        for (std::size_t i = 0; i < matchLength; ++i) {
+            dst[op + i] = match[i];
+        }
+        op += matchLength;
+    }
+
+    return op == dstSize;
+}
@@ -0,0 +1,298 @@
+#include "DynamicAabbTree.h"
+
+Aabb Aabb::fromRect(const sf::FloatRect& rect) {
+    return Aabb{rect.left, rect.top, rect.left + rect.width, rect.top + rect.height};
+}
+
+Aabb Aabb::combine(const Aabb& a, const Aabb& b) {
+    return Aabb{std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+                std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+}
+
+bool Aabb::overlaps(const Aabb& other) const {
+    return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+}
+
+bool Aabb::contains(const Aabb& other) const {
+    return minX <= other.minX && minY <= other.minY && other.maxX <= maxX && other.maxY <= maxY;
+}
+
+float Aabb::perimeter() const {
+    return 2.f * ((maxX - minX) + (maxY - minY));
+}
+
+float Aabb::distanceSquared(float x, float y) const {
+    float dx = std::max(std::max(minX - x, 0.f), x - maxX);
+    float dy = std::max(std::max(minY - y, 0.f), y - maxY);
+    return dx * dx + dy * dy;
+}
+
+DynamicAabbTree::DynamicAabbTree(float m)
+    : root(NULL_NODE)
+    , freeList(NULL_NODE)
+    , proxyCount(0)
+    , margin(m) {}
+
+int DynamicAabbTree::allocateNode() {
+    if (freeList == NULL_NODE) {
+        nodes.push_back(Node());
+        freeList = static_cast<int>(nodes.size()) - 1;
+        nodes[freeList].parent = NULL_NODE;
+    }
+
+    int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node].parent = NULL_NODE;
+    nodes[node].child1 = NULL_NODE;
+    nodes[node].child2 = NULL_NODE;
+    nodes[node].height = 0;
+    return node;
+}
+
+void DynamicAabbTree::freeNode(int node) {
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+}
+
+int DynamicAabbTree::createProxy(const Aabb& box) {
+    int proxy = allocateNode();
+    nodes[proxy].box = Aabb{box.minX - margin, box.minY - margin, box.maxX + margin, box.maxY + margin};
+    insertLeaf(proxy);
+    ++proxyCount;
+    return proxy;
+}
+
+void DynamicAabbTree::destroyProxy(int proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --proxyCount;
+}
+
+bool DynamicAabbTree::moveProxy(int proxy, const Aabb& box, float dx, float dy) {
+    if (nodes[proxy].box.contains(box)) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+
+    // Grow by the margin, then a couple of frames ahead along the motion
+    Aabb fat{box.minX - margin, box.minY - margin, box.maxX + margin, box.maxY + margin};
+    const float PREDICT = 2.f;
+    if (dx < 0.f) fat.minX += PREDICT * dx; else fat.maxX += PREDICT * dx;
+    if (dy < 0.f) fat.minY += PREDICT * dy; else fat.maxY += PREDICT * dy;
+    nodes[proxy].box = fat;
+
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicAabbTree::clear() {
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    proxyCount = 0;
+}
+
+void DynamicAabbTree::reserve(int proxies) {
+    // n leaves need n - 1 internal nodes
+    nodes.reserve(static_cast<std::size_t>(std::max(0, 2 * proxies - 1)));
+}
+
+void DynamicAabbTree::insertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend to the cheapest sibling (perimeter heuristic)
+    Aabb leafBox = nodes[leaf].box;
+    int index = root;
+    while (!nodes[index].isLeaf()) {
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+
+        float area = nodes[index].box.perimeter();
+        float combinedArea = Aabb::combine(nodes[index].box, leafBox).perimeter();
+
+        // Cost of making a new parent for this node and the leaf
+        float cost = 2.f * combinedArea;
+        // Minimum cost of pushing the leaf further down
+        float inheritanceCost = 2.f * (combinedArea - area);
+
+        float cost1 = Aabb::combine(leafBox, nodes[child1].box).perimeter() + inheritanceCost;
+        if (!nodes[child1].isLeaf()) cost1 -= nodes[child1].box.perimeter();
+        float cost2 = Aabb::combine(leafBox, nodes[child2].box).perimeter() + inheritanceCost;
+        if (!nodes[child2].isLeaf()) cost2 -= nodes[child2].box.perimeter();
+
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? child1 : child2;
+    }
+    int sibling = index;
+
+    // New parent takes the sibling's place
+    int oldParent = nodes[sibling].parent;
+    int newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].box = Aabb::combine(leafBox, nodes[sibling].box);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+        else nodes[oldParent].child2 = newParent;
+    } else {
+        root = newParent;
+    }
+
+    // Refit and rebalance up to the root
+    index = nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        nodes[index].box = Aabb::combine(nodes[child1].box, nodes[child2].box);
+        index = nodes[index].parent;
+    }
+}
+
+void DynamicAabbTree::removeLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grandParent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // Sibling replaces the parent
+    if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+    else nodes[grandParent].child2 = sibling;
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    int index = grandParent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        int child1 = nodes[index].child1;
+        int child2 = nodes[index].child2;
+        nodes[index].box = Aabb::combine(nodes[child1].box, nodes[child2].box);
+        nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+        index = nodes[index].parent;
+    }
+}
+
+// Rotates the taller grandchild up when the children's heights differ by more
+// than one. Returns the index of the subtree root after rotation.
+int DynamicAabbTree::balance(int a) {
+    Node& nodeA = nodes[a];
+    if (nodeA.isLeaf() || nodeA.height < 2) {
+        return a;
+    }
+
+    int b = nodeA.child1;
+    int c = nodeA.child2;
+    int heightDiff = nodes[c].height - nodes[b].height;
+
+    // Rotate c up
+    if (heightDiff > 1) {
+        int f = nodes[c].child1;
+        int g = nodes[c].child2;
+
+        nodes[c].child1 = a;
+        nodes[c].parent = nodes[a].parent;
+        nodes[a].parent = c;
+
+        int cParent = nodes[c].parent;
+        if (cParent != NULL_NODE) {
+            if (nodes[cParent].child1 == a) nodes[cParent].child1 = c;
+            else nodes[cParent].child2 = c;
+        } else {
+            root = c;
+        }
+
+        // Keep the taller of f/g under c
+        if (nodes[f].height > nodes[g].height) {
+            nodes[c].child2 = f;
+            nodes[a].child2 = g;
+            nodes[g].parent = a;
+            nodes[a].box = Aabb::combine(nodes[b].box, nodes[g].box);
+            nodes[c].box = Aabb::combine(nodes[a].box, nodes[f].box);
+            nodes[a].height = 1 + std::max(nodes[b].height, nodes[g].height);
+            nodes[c].height = 1 + std::max(nodes[a].height, nodes[f].height);
+        } else {
+            nodes[c].child2 = g;
+            nodes[a].child2 = f;
+            nodes[f].parent = a;
+            nodes[a].box = Aabb::combine(nodes[b].box, nodes[f].box);
+            nodes[c].box = Aabb::combine(nodes[a].box, nodes[g].box);
+            nodes[a].height = 1 + std::max(nodes[b].height, nodes[f].height);
+            nodes[c].height = 1 + std::max(nodes[a].height, nodes[g].height);
+        }
+        return c;
+    }
+
+    // Rotate b up
+    if (heightDiff < -1) {
+        int d = nodes[b].child1;
+        int e = nodes[b].child2;
+
+        nodes[b].child1 = a;
+        nodes[b].parent = nodes[a].parent;
+        nodes[a].parent = b;
+
+        int bParent = nodes[b].parent;
+        if (bParent != NULL_NODE) {
+            if (nodes[bParent].child1 == a) nodes[bParent].child1 = b;
+            else nodes[bParent].child2 = b;
+        } else {
+            root = b;
+        }
+
+        if (nodes[d].height > nodes[e].height) {
+            nodes[b].child2 = d;
+            nodes[a].child1 = e;
+            nodes[e].parent = a;
+            nodes[a].box = Aabb::combine(nodes[c].box, nodes[e].box);
+            nodes[b].box = Aabb::combine(nodes[a].box, nodes[d].box);
+            nodes[a].height = 1 + std::max(nodes[c].height, nodes[e].height);
+            nodes[b].height = 1 + std::max(nodes[a].height, nodes[d].height);
+        } else {
+            nodes[b].child2 = e;
+            nodes[a].child1 = d;
+            nodes[d].parent = a;
+            nodes[a].box = Aabb::combine(nodes[c].box, nodes[d].box);
+            nodes[b].box = Aabb::combine(nodes[a].box, nodes[e].box);
+            nodes[a].height = 1 + std::max(nodes[c].height, nodes[d].height);
+            nodes[b].height = 1 + std::max(nodes[a].height, nodes[e].height);
+        }
+        return b;
+    }
+
+    return a;
+}
+
+const Aabb& DynamicAabbTree::getFatBox(int proxy) const {
+    return nodes[proxy].box;
+}
+
+int DynamicAabbTree::getHeight() const {
+    return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+int DynamicAabbTree::getProxyCount() const {
+    return proxyCount;
+}
@@ -1,24 +1,34 @@
 #include "Enemy.h"
-#include "ResourceManager.h"
+#include "Playfield.h"
 
-Enemy::Enemy(float x, float y, float speedMultiplier) : scoreValue(10) {
-    speed = 100.f * speedMultiplier;
-    setTexture(ResourceManager::getInstance().getTexture("enemy"));
-    
-    // Center the origin
-    sf::FloatRect bounds = sprite.getLocalBounds();
-    sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+Enemy::Enemy(float x, float y, MoverHandle m, const sf::Texture* texture) : scoreValue(10), mover(m), proxy(-1) {
+    initSprite(texture, 32.f, 32.f);
     
     setPosition(x, y);
-    velocity.y = speed;
 }
 
-void Enemy::update(float dt) {
-    // Move downward
-    sprite.move(velocity * dt);
-    
-    // Deactivate if off-screen
-    if (sprite.getPosition().y > 650.f) {
+void Enemy::respawn(float x, float y, MoverHandle m) {
+    mover = m;
+    proxy = -1;
+    emitter.reset();
+    active = true;
+    setPosition(x, y);
+}
+
+void Enemy::update(float) {
+    // Movement is evaluated in batch by the MovementSystem; only cull here
+    sf::Vector2f pos = sprite.getPosition();
+    if (pos.y > Playfield::HEIGHT + Playfield::ENEMY_CULL_BOTTOM || pos.x < -Playfield::ENEMY_CULL_SIDE ||
+        pos.x > Playfield::WIDTH + Playfield::ENEMY_CULL_SIDE) {
+        active = false;
+    }
+}
+
+void Enemy::updateFixed(const FixedVec2& pos) {
+    setFixedPosition(pos);
+    if (pos.y > Fixed::fromFloat(Playfield::HEIGHT + Playfield::ENEMY_CULL_BOTTOM) ||
+        pos.x < -Fixed::fromFloat(Playfield::ENEMY_CULL_SIDE) ||
+        pos.x > Fixed::fromFloat(Playfield::WIDTH + Playfield::ENEMY_CULL_SIDE)) {
         active = false;
     }
 }
@@ -26,3 +36,33 @@ void Enemy::update(float dt) {
 int Enemy::getScoreValue() const {
     return scoreValue;
 }
+
+MoverHandle Enemy::getMover() const {
+    return mover;
+}
+
+int Enemy::getProxy() const {
+    return proxy;
+}
+
+void Enemy::setProxy(int p) {
+    proxy = p;
+}
+
+void Enemy::arm(const BulletPattern& pattern, float initialDelay) {
+    emitter.emplace(pattern, initialDelay);
+}
+
+bool Enemy::updateWeapon(float dt, const sf::Vector2f& target, ProjectileSystem& projectiles) {
+    if (emitter && active) {
+        return emitter->update(dt, sprite.getPosition(), target, projectiles);
+    }
+    return false;
+}
+
+bool Enemy::updateWeaponFixed(const FixedVec2& target, int ticksPerSecond, ProjectileSystem& projectiles) {
+    if (emitter && active) {
+        return emitter->updateFixed(fixedPosition, target, ticksPerSecond, projectiles);
+    }
+    return false;
+}
@@ -0,0 +1,108 @@
+#include "EngineMetrics.h"
+#include "Simulation.h"
+
+namespace {
+    // Frame times around the 60 Hz budget, in seconds
+    const std::vector<double> FRAME_BUCKETS = { 0.002, 0.004, 0.008, 0.0125, 0.0167, 0.025, 0.0333, 0.05, 0.1, 0.25 };
+    const std::vector<double> SCORE_BUCKETS = { 50, 100, 200, 300, 400, 500, 750, 1000, 2000, 5000 };
+}
+
+EngineMetrics::EngineMetrics()
+    : frames(registry.counter("spaceshooter_frames_total", "Frames rendered during gameplay"))
+    , frameSeconds(registry.histogram("spaceshooter_frame_seconds", "Gameplay frame time", FRAME_BUCKETS))
+    , ticks(registry.counter("spaceshooter_ticks_total", "Simulation ticks stepped"))
+    , sessions(registry.counter("spaceshooter_sessions_total", "Sessions finished"))
+    , sessionScore(registry.histogram("spaceshooter_session_score", "Final score of finished sessions", SCORE_BUCKETS))
+    , enemies(registry.gauge("spaceshooter_enemies", "Live enemies"))
+    , bullets(registry.gauge("spaceshooter_bullets", "Live player bullets"))
+    , projectiles(registry.gauge("spaceshooter_enemy_projectiles", "Live enemy projectiles"))
+    , particles(registry.gauge("spaceshooter_particles", "Live particles"))
+    , enemiesSpawned(registry.counter("spaceshooter_enemies_spawned_total", "Enemies spawned"))
+    , enemiesDestroyed(registry.counter("spaceshooter_enemies_destroyed_total", "Enemies shot down"))
+    , playerDamage(registry.counter("spaceshooter_player_damage_total", "Damage taken by the player"))
+    , collisionPairs(registry.counter("spaceshooter_collision_pairs_total", "Entity pairs passing the bounding box test"))
+    , maskTests(registry.counter("spaceshooter_collision_mask_tests_total", "Pixel mask tests"))
+    , maskRejects(registry.counter("spaceshooter_collision_mask_rejects_total", "Box overlaps rejected by the pixel masks"))
+    , score(registry.gauge("spaceshooter_score", "Score of the current session"))
+    , difficulty(registry.gauge("spaceshooter_difficulty", "Difficulty level of the current session"))
+    , health(registry.gauge("spaceshooter_player_health", "Player health in the current session"))
+    , publishedSpawns(0) {}
+
+void EventTally::add(const GameEventQueue& events) {
+    for (const GameEvent& event : events) {
+        if (event.type == GameEventType::ENEMY_DESTROYED) {
+            ++enemiesDestroyed;
+        } else if (event.type == GameEventType::PLAYER_RAMMED || event.type == GameEventType::PLAYER_SHOT) {
+            playerDamage += static_cast<std::uint64_t>(event.value);
+        }
+    }
+}
+
+void EngineMetrics::startSession() {
+    publishedSpawns = 0;
+    publishedCollisions = CollisionStats();
+}
+
+void EngineMetrics::recordTick(const Simulation& simulation) {
+    ticks.add();
+
+    if (!simulation.getEvents().empty()) {
+        EventTally events;
+        events.add(simulation.getEvents());
+        addEvents(events);
+    }
+
+    std::uint64_t spawned = simulation.getEnemiesSpawned();
+    if (spawned != publishedSpawns) {
+        enemiesSpawned.add(spawned - publishedSpawns);
+        publishedSpawns = spawned;
+    }
+
+    const CollisionStats& stats = simulation.getCollisionStats();
+    CollisionStats growth;
+    growth.boxOverlaps = stats.boxOverlaps - publishedCollisions.boxOverlaps;
+    growth.maskTests = stats.maskTests - publishedCollisions.maskTests;
+    growth.maskRejects = stats.maskRejects - publishedCollisions.maskRejects;
+    addCollisions(growth);
+    publishedCollisions = stats;
+}
+
+void EngineMetrics::recordFrame(float seconds, const Simulation* simulation, std::size_t liveParticles) {
+    frames.add();
+    frameSeconds.observe(seconds);
+    particles.set(static_cast<double>(liveParticles));
+
+    if (simulation) {
+        enemies.set(static_cast<double>(simulation->getEnemies().size()));
+        bullets.set(static_cast<double>(simulation->getBulletCount()));
+        projectiles.set(static_cast<double>(simulation->getEnemyProjectiles().size()));
+        score.set(simulation->getScore());
+        difficulty.set(simulation->getDifficulty());
+        health.set(simulation->getPlayer().getHealth());
+    }
+}
+
+void EngineMetrics::endSession(int finalScore) {
+    sessions.add();
+    sessionScore.observe(finalScore);
+}
+
+void EngineMetrics::recordSession(const Simulation& simulation, const EventTally& events) {
+    ticks.add(simulation.getTick());
+    enemiesSpawned.add(simulation.getEnemiesSpawned());
+    addEvents(events);
+    addCollisions(simulation.getCollisionStats());
+    endSession(simulation.getScore());
+}
+
+void EngineMetrics::addEvents(const EventTally& events) {
+    if (events.enemiesDestroyed) enemiesDestroyed.add(events.enemiesDestroyed);
+    if (events.playerDamage) playerDamage.add(events.playerDamage);
+}
+
+void EngineMetrics::addCollisions(const CollisionStats& stats) {
+    // Most ticks collide nothing; skip the shared cache lines then
+    if (stats.boxOverlaps) collisionPairs.add(stats.boxOverlaps);
+    if (stats.maskTests) maskTests.add(stats.maskTests);
+    if (stats.maskRejects) maskRejects.add(stats.maskRejects);
+}
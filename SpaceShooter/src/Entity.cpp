@@ -1,10 +1,23 @@
 #include "Entity.h"
 
-Entity::Entity() : velocity(0.f, 0.f), active(true), speed(0.f) {}
+Entity::Entity() : velocity(0.f, 0.f), active(true), speed(0.f), hitboxSize(0.f, 0.f) {}
 
-void Entity::render(sf::RenderWindow& window) {
+void Entity::initSprite(const sf::Texture* texture, float width, float height) {
+    hitboxSize = sf::Vector2f(width, height);
+    fixedHitboxSize = FixedVec2(Fixed::fromFloat(width), Fixed::fromFloat(height));
+    
+    if (texture) {
+        sprite.setTexture(*texture);
+        
+        // Center the origin
+        sf::FloatRect bounds = sprite.getLocalBounds();
+        sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+    }
+}
+
+void Entity::render(RenderBackend& backend) {
     if (active) {
-        window.draw(sprite);
+        backend.drawSprite(sprite);
     }
 }
 
@@ -21,7 +34,22 @@ void Entity::setPosition(const sf::Vector2f& pos) {
 }
 
 sf::FloatRect Entity::getBounds() const {
-    return sprite.getGlobalBounds();
+    sf::Vector2f pos = sprite.getPosition();
+    return sf::FloatRect(pos.x - hitboxSize.x / 2.f, pos.y - hitboxSize.y / 2.f, hitboxSize.x, hitboxSize.y);
+}
+
+void Entity::setFixedPosition(const FixedVec2& pos) {
+    fixedPosition = pos;
+    sprite.setPosition(pos.x.toFloat(), pos.y.toFloat());
+}
+
+const FixedVec2& Entity::getFixedPosition() const {
+    return fixedPosition;
+}
+
+FixedRect Entity::getFixedBounds() const {
+    return FixedRect{fixedPosition.x - fixedHitboxSize.x / 2, fixedPosition.y - fixedHitboxSize.y / 2,
+                     fixedHitboxSize.x, fixedHitboxSize.y};
 }
 
 bool Entity::isActive() const {
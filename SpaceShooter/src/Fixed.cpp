@@ -0,0 +1,67 @@
+#include "Fixed.h"
+
+namespace {
+    const Fixed HALF = Fixed::fromRaw(Fixed::ONE / 2);
+    const Fixed QUARTER = Fixed::fromRaw(Fixed::ONE / 4);
+
+    // Refinement weight of the parabolic sine (same as MovementSystem's float version)
+    const Fixed SINE_REFINE = Fixed::fromRaw(14746);        // 0.225
+
+    // atan(z) on [0, 1] in turns: z/8 + z(1-z)(A + Bz)
+    const Fixed ATAN_A = Fixed::fromRaw(2552);              // 0.03895
+    const Fixed ATAN_B = Fixed::fromRaw(691);               // 0.01055
+
+    Fixed atanUnitTurns(Fixed z) {
+        return z / 8 + z * (Fixed::fromInt(1) - z) * (ATAN_A + ATAN_B * z);
+    }
+}
+
+Fixed Fixed::sqrt(Fixed value) {
+    if (value.raw <= 0) {
+        return Fixed();
+    }
+
+    // sqrt(raw / 2^16) * 2^16 = sqrt(raw * 2^16)
+    std::uint64_t n = static_cast<std::uint64_t>(value.raw) << FRACTION_BITS;
+    std::uint64_t result = 0;
+    std::uint64_t bit = std::uint64_t(1) << 62;
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= result + bit) {
+            n -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return fromRaw(static_cast<std::int32_t>(result));
+}
+
+Fixed Fixed::sinTurns(Fixed turns) {
+    // Phase in [-0.5, 0.5): masking the fraction bits floors in two's complement
+    Fixed phase = turns - fromRaw((turns + HALF).raw & ~(ONE - 1));
+    Fixed y = phase * 8 - phase * phase.abs() * 16;
+    return SINE_REFINE * (y * y.abs() - y) + y;
+}
+
+Fixed Fixed::cosTurns(Fixed turns) {
+    return sinTurns(turns + QUARTER);
+}
+
+Fixed Fixed::atan2Turns(Fixed y, Fixed x) {
+    if (x.raw == 0 && y.raw == 0) {
+        return Fixed();
+    }
+
+    // Reduce to the first octant, then mirror back
+    Fixed ax = x.abs();
+    Fixed ay = y.abs();
+    Fixed angle = ax >= ay ? atanUnitTurns(ay / ax) : QUARTER - atanUnitTurns(ax / ay);
+    if (x.raw < 0) {
+        angle = HALF - angle;
+    }
+    return y.raw < 0 ? -angle : angle;
+}
@@ -0,0 +1,401 @@
+#include "FrameCapture.h"
+#include "Profiler.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+namespace {
+    // Buffer object and sync entry points (GL 1.5 / 2.1 / 3.2) aren't exported
+    // by every GL library, so they're looked up through SFML's context
+    typedef void (APIENTRY* GenBuffersFn)(GLsizei, GLuint*);
+    typedef void (APIENTRY* DeleteBuffersFn)(GLsizei, const GLuint*);
+    typedef void (APIENTRY* BindBufferFn)(GLenum, GLuint);
+    typedef void (APIENTRY* BufferDataFn)(GLenum, std::ptrdiff_t, const void*, GLenum);
+    typedef void* (APIENTRY* MapBufferFn)(GLenum, GLenum);
+    typedef GLboolean (APIENTRY* UnmapBufferFn)(GLenum);
+    typedef void* (APIENTRY* FenceSyncFn)(GLenum, GLbitfield);
+    typedef GLenum (APIENTRY* ClientWaitSyncFn)(void*, GLbitfield, std::uint64_t);
+    typedef void (APIENTRY* DeleteSyncFn)(void*);
+
+    struct GlFunctions {
+        GenBuffersFn genBuffers = nullptr;
+        DeleteBuffersFn deleteBuffers = nullptr;
+        BindBufferFn bindBuffer = nullptr;
+        BufferDataFn bufferData = nullptr;
+        MapBufferFn mapBuffer = nullptr;
+        UnmapBufferFn unmapBuffer = nullptr;
+        FenceSyncFn fenceSync = nullptr;
+        ClientWaitSyncFn clientWaitSync = nullptr;
+        DeleteSyncFn deleteSync = nullptr;
+    } gl;
+
+    const GLenum PIXEL_PACK_BUFFER = 0x88EB;
+    const GLenum STREAM_READ = 0x88E1;
+    const GLenum READ_ONLY = 0x88B8;
+    const GLenum SYNC_GPU_COMMANDS_COMPLETE = 0x9117;
+    const GLenum ALREADY_SIGNALED = 0x911A;
+    const GLenum CONDITION_SATISFIED = 0x911C;
+    const GLbitfield SYNC_FLUSH_COMMANDS_BIT = 0x1;
+
+    // Only stop() waits, and only this long per readback
+    const std::uint64_t STOP_TIMEOUT_NS = 1000000000;
+    const auto ENCODER_IDLE = std::chrono::milliseconds(1);
+
+    template <typename T>
+    bool load(T& function, const char* name) {
+        function = reinterpret_cast<T>(sf::Context::getFunction(name));
+        return function != nullptr;
+    }
+
+    std::uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+
+    const char* formatName(CaptureFormat format) {
+        switch (format) {
+            case CaptureFormat::RAW:  return "raw";
+            case CaptureFormat::PNG:  return "png";
+            case CaptureFormat::PIPE: return "pipe";
+        }
+        return "";
+    }
+}
+
+FrameCapture::FrameCapture()
+    : format(CaptureFormat::PNG)
+    , width(0)
+    , height(0)
+    , frameBytes(0)
+    , running(false)
+    , asyncReadback(false)
+    , useFences(false)
+    , source(nullptr)
+    , slots()
+    , nextSlot(0)
+    , frameCounter(0)
+    , pipe(nullptr)
+    , encoding(false) {}
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(sf::RenderTexture& target, CaptureFormat captureFormat, const std::string& dest) {
+    if (running) return false;
+
+    format = captureFormat;
+    destination = dest;
+    width = target.getSize().x;
+    height = target.getSize().y;
+    frameBytes = static_cast<std::size_t>(width) * height * 4;
+
+    if (format == CaptureFormat::PIPE) {
+        // A failed encoder shows up as write errors instead of killing the game
+        std::signal(SIGPIPE, SIG_IGN);
+        pipe = popen(destination.c_str(), "w");
+        if (!pipe) {
+            std::cerr << "Failed to start capture encoder: " << destination << std::endl;
+            return false;
+        }
+    } else {
+        std::error_code error;
+        std::filesystem::create_directories(destination, error);
+        if (error) {
+            std::cerr << "Failed to create capture directory " << destination << ": " << error.message() << std::endl;
+            return false;
+        }
+    }
+
+    source = &target;
+    if (!source->setActive(true)) {
+        std::cerr << "Failed to activate the capture target" << std::endl;
+        if (pipe) {
+            pclose(pipe);
+            pipe = nullptr;
+        }
+        return false;
+    }
+    asyncReadback = createBuffers();
+    if (!asyncReadback) {
+        std::cerr << "Pixel buffer objects unavailable, frames are read back synchronously" << std::endl;
+    }
+
+    for (int i = 0; i < FRAME_BUFFERS; ++i) {
+        frames[i].resize(frameBytes);
+        freeFrames.push(i);
+    }
+    stats = Stats();
+    frameCounter = 0;
+    nextSlot = 0;
+
+    encoding = true;
+    encoder = std::thread(&FrameCapture::encoderLoop, this);
+    running = true;
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!running) return;
+
+    if (asyncReadback && source->setActive(true)) {
+        collect(true);
+        destroyBuffers();
+    }
+
+    encoding = false;
+    encoder.join();
+
+    if (pipe) {
+        if (pclose(pipe) != 0) {
+            std::cerr << "Capture encoder exited with an error" << std::endl;
+        }
+        pipe = nullptr;
+    }
+
+    // Leave the queues empty for a restart
+    int index;
+    while (filledFrames.pop(index)) {}
+    while (freeFrames.pop(index)) {}
+    running = false;
+}
+
+bool FrameCapture::isRunning() const {
+    return running;
+}
+
+void FrameCapture::capture() {
+    if (!running) return;
+
+    auto start = std::chrono::steady_clock::now();
+    ++stats.frames;
+
+    if (source->setActive(true)) {
+        if (asyncReadback) {
+            // Hand finished readbacks to the encoder, then reuse the oldest slot
+            // if it is free; with every slot still busy the GPU is behind
+            collect(false);
+            Slot& slot = slots[nextSlot];
+            if (slot.pending) {
+                ++stats.droppedGpu;
+            } else {
+                issue(slot);
+                nextSlot = (nextSlot + 1) % READBACK_SLOTS;
+            }
+        } else {
+            // Fallback: glReadPixels into client memory waits for the frame to finish
+            int index;
+            if (freeFrames.pop(index)) {
+                glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, frames[index].data());
+                filledFrames.push(index);
+                ++stats.readBack;
+            } else {
+                ++stats.droppedEncoder;
+            }
+        }
+    }
+    ++frameCounter;
+
+    std::uint64_t ns = elapsedNs(start);
+    stats.captureNs += ns;
+    stats.captureMaxNs = std::max(stats.captureMaxNs, ns);
+}
+
+const FrameCapture::Stats& FrameCapture::getStats() const {
+    return stats;
+}
+
+void FrameCapture::report(std::ostream& out) const {
+    const char* readback = !asyncReadback ? "synchronous readback"
+                         : useFences ? "async readback, fenced" : "async readback, frame-delayed";
+    out << "Capture (" << formatName(format) << ", " << readback << ", " << width << "x" << height << "): "
+        << stats.frames << " frames, " << stats.written << " written, "
+        << stats.droppedGpu + stats.droppedEncoder << " dropped (" << stats.droppedGpu << " GPU busy, "
+        << stats.droppedEncoder << " encoder behind), " << stats.writeErrors << " write errors" << std::endl;
+
+    double meanMs = stats.frames > 0 ? stats.captureNs / 1.0e6 / stats.frames : 0.0;
+    std::uint64_t encoded = stats.written + stats.writeErrors;
+    double encodeMs = encoded > 0 ? stats.encodeNs / 1.0e6 / encoded : 0.0;
+    out << "  added frame time: mean " << meanMs << " ms, max " << stats.captureMaxNs / 1.0e6
+        << " ms; encoder thread " << encodeMs << " ms/frame" << std::endl;
+}
+
+bool FrameCapture::createBuffers() {
+    int major = 0, minor = 0;
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (version) {
+        std::sscanf(version, "%d.%d", &major, &minor);
+    }
+    int glVersion = major * 10 + minor;
+
+    bool buffers = glVersion >= 21 || sf::Context::isExtensionAvailable("GL_ARB_pixel_buffer_object");
+    buffers = buffers && load(gl.genBuffers, "glGenBuffers") && load(gl.deleteBuffers, "glDeleteBuffers")
+        && load(gl.bindBuffer, "glBindBuffer") && load(gl.bufferData, "glBufferData")
+        && load(gl.mapBuffer, "glMapBuffer") && load(gl.unmapBuffer, "glUnmapBuffer");
+    if (!buffers) {
+        return false;
+    }
+
+    useFences = (glVersion >= 32 || sf::Context::isExtensionAvailable("GL_ARB_sync"))
+        && load(gl.fenceSync, "glFenceSync") && load(gl.clientWaitSync, "glClientWaitSync")
+        && load(gl.deleteSync, "glDeleteSync");
+
+    for (Slot& slot : slots) {
+        gl.genBuffers(1, &slot.buffer);
+        gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+        gl.bufferData(PIXEL_PACK_BUFFER, static_cast<std::ptrdiff_t>(frameBytes), nullptr, STREAM_READ);
+        slot.fence = nullptr;
+        slot.frame = 0;
+        slot.pending = false;
+    }
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+    return true;
+}
+
+void FrameCapture::destroyBuffers() {
+    for (Slot& slot : slots) {
+        if (slot.fence) {
+            gl.deleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        gl.deleteBuffers(1, &slot.buffer);
+        slot.buffer = 0;
+        slot.pending = false;
+    }
+}
+
+void FrameCapture::issue(Slot& slot) {
+    // With a pack buffer bound the read only queues a copy on the GPU
+    gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = useFences ? gl.fenceSync(SYNC_GPU_COMMANDS_COMPLETE, 0) : nullptr;
+    slot.frame = frameCounter;
+    slot.pending = true;
+}
+
+bool FrameCapture::isComplete(const Slot& slot, bool wait) const {
+    if (!useFences) {
+        // Without fences, assume the GPU is at most a couple of frames behind
+        return wait || frameCounter - slot.frame >= READBACK_SLOTS - 1;
+    }
+    GLenum result = gl.clientWaitSync(slot.fence, wait ? SYNC_FLUSH_COMMANDS_BIT : 0, wait ? STOP_TIMEOUT_NS : 0);
+    return result == ALREADY_SIGNALED || result == CONDITION_SATISFIED;
+}
+
+void FrameCapture::collect(bool wait) {
+    // Oldest first, so frames reach the encoder in order
+    for (int i = 0; i < READBACK_SLOTS; ++i) {
+        Slot& slot = slots[(nextSlot + i) % READBACK_SLOTS];
+        if (!slot.pending) continue;
+
+        if (isComplete(slot, wait)) {
+            transfer(slot, wait);
+        } else if (wait) {
+            ++stats.droppedGpu;
+        } else {
+            break;
+        }
+
+        if (slot.fence) {
+            gl.deleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        slot.pending = false;
+    }
+}
+
+void FrameCapture::transfer(Slot& slot, bool wait) {
+    gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+    const void* pixels = gl.mapBuffer(PIXEL_PACK_BUFFER, READ_ONLY);
+    if (!pixels) {
+        ++stats.droppedGpu;
+    } else {
+        int index = -1;
+        bool free = freeFrames.pop(index);
+        while (!free && wait) {
+            std::this_thread::sleep_for(ENCODER_IDLE);
+            free = freeFrames.pop(index);
+        }
+
+        if (free) {
+            std::memcpy(frames[index].data(), pixels, frameBytes);
+            filledFrames.push(index);
+            ++stats.readBack;
+        } else {
+            ++stats.droppedEncoder;
+        }
+        gl.unmapBuffer(PIXEL_PACK_BUFFER);
+    }
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCapture::encoderLoop() {
+    // Drains the queue before exiting once stop() cleared encoding
+    while (true) {
+        int index;
+        if (filledFrames.pop(index)) {
+            writeFrame(index);
+            freeFrames.push(index);
+        } else if (encoding) {
+            std::this_thread::sleep_for(ENCODER_IDLE);
+        } else if (filledFrames.size() == 0) {
+            break;      // Frames pushed before encoding was cleared are visible here
+        }
+    }
+}
+
+void FrameCapture::writeFrame(int index) {
+    ProfileZone zone("capture");
+    auto start = std::chrono::steady_clock::now();
+
+    // GL rows run bottom-up
+    std::vector<std::uint8_t>& pixels = frames[index];
+    std::size_t row = static_cast<std::size_t>(width) * 4;
+    for (unsigned int y = 0; y < height / 2; ++y) {
+        std::swap_ranges(pixels.begin() + y * row, pixels.begin() + (y + 1) * row,
+                         pixels.begin() + (height - 1 - y) * row);
+    }
+
+    // Output files are numbered without gaps (dropped frames are only counted)
+    unsigned long long sequence = stats.written + stats.writeErrors + 1;
+    char path[1024];
+    bool written = false;
+    switch (format) {
+        case CaptureFormat::RAW: {
+            std::snprintf(path, sizeof(path), "%s/frame_%06llu.rgba", destination.c_str(), sequence);
+            std::FILE* file = std::fopen(path, "wb");
+            if (file) {
+                written = std::fwrite(pixels.data(), 1, frameBytes, file) == frameBytes;
+                written = std::fclose(file) == 0 && written;
+            }
+            break;
+        }
+        case CaptureFormat::PNG: {
+            std::snprintf(path, sizeof(path), "%s/frame_%06llu.png", destination.c_str(), sequence);
+            sf::Image image;
+            image.create(width, height, pixels.data());
+            written = image.saveToFile(path);
+            break;
+        }
+        case CaptureFormat::PIPE:
+            written = std::fwrite(pixels.data(), 1, frameBytes, pipe) == frameBytes;
+            break;
+    }
+
+    if (written) {
+        ++stats.written;
+    } else {
+        ++stats.writeErrors;
+    }
+    stats.encodeNs += elapsedNs(start);
+}
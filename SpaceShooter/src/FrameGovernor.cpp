@@ -0,0 +1,104 @@
+#include "FrameGovernor.h"
+
+namespace {
+    struct QualityLevel {
+        float particleScale;
+        std::size_t starLimit;
+        float renderScale;
+    };
+
+    // Cheapest savings first: particles, then stars, then fill rate
+    const QualityLevel LEVELS[] = {
+        {1.00f, 150, 1.00f},
+        {0.60f, 120, 1.00f},
+        {0.35f,  90, 0.85f},
+        {0.20f,  60, 0.70f},
+        {0.10f,  40, 0.50f}
+    };
+    const int LEVEL_COUNT = sizeof(LEVELS) / sizeof(LEVELS[0]);
+
+    const float SMOOTHING = 0.1f;            // Exponential moving average weight
+    const float MISSED_FRAME_RATIO = 1.2f;   // Frame took noticeably longer than budget
+    const float WORK_LIMIT_RATIO = 0.85f;    // Work is eating nearly all of the budget
+    const float HEADROOM_RATIO = 0.5f;       // Work fits twice into the budget
+    const int DOWNGRADE_FRAMES = 30;         // ~0.5s of sustained overload
+    const int UPGRADE_FRAMES = 180;          // ~3s of sustained headroom
+}
+
+FrameGovernor::FrameGovernor(float targetFps)
+    : budget(1.f / targetFps)
+    , smoothedFrameTime(1.f / targetFps)
+    , smoothedWorkTime(0.f)
+    , level(0)
+    , overBudgetFrames(0)
+    , headroomFrames(0)
+    , telemetry() {
+    telemetry.budgetMs = budget * 1000.f;
+    applyLevel();
+}
+
+bool FrameGovernor::recordFrame(float frameTime, float workTime) {
+    smoothedFrameTime += (frameTime - smoothedFrameTime) * SMOOTHING;
+    smoothedWorkTime += (workTime - smoothedWorkTime) * SMOOTHING;
+    telemetry.frameTimeMs = smoothedFrameTime * 1000.f;
+    telemetry.workTimeMs = smoothedWorkTime * 1000.f;
+
+    bool overBudget = smoothedFrameTime > budget * MISSED_FRAME_RATIO
+                   || smoothedWorkTime > budget * WORK_LIMIT_RATIO;
+    bool headroom = !overBudget && smoothedWorkTime < budget * HEADROOM_RATIO;
+
+    overBudgetFrames = overBudget ? overBudgetFrames + 1 : 0;
+    headroomFrames = headroom ? headroomFrames + 1 : 0;
+
+    if (overBudgetFrames >= DOWNGRADE_FRAMES && level < LEVEL_COUNT - 1) {
+        ++level;
+        ++telemetry.downgrades;
+    } else if (headroomFrames >= UPGRADE_FRAMES && level > 0) {
+        --level;
+        ++telemetry.upgrades;
+    } else {
+        return false;
+    }
+
+    // Give the new level time to take effect before judging it
+    overBudgetFrames = 0;
+    headroomFrames = 0;
+    applyLevel();
+    return true;
+}
+
+void FrameGovernor::reset() {
+    level = 0;
+    overBudgetFrames = 0;
+    headroomFrames = 0;
+    smoothedFrameTime = budget;
+    smoothedWorkTime = 0.f;
+    applyLevel();
+}
+
+void FrameGovernor::applyLevel() {
+    telemetry.level = level;
+    telemetry.particleScale = LEVELS[level].particleScale;
+    telemetry.starLimit = LEVELS[level].starLimit;
+    telemetry.renderScale = LEVELS[level].renderScale;
+}
+
+float FrameGovernor::getParticleScale() const {
+    return LEVELS[level].particleScale;
+}
+
+std::size_t FrameGovernor::getStarLimit() const {
+    return LEVELS[level].starLimit;
+}
+
+float FrameGovernor::getRenderScale() const {
+    return LEVELS[level].renderScale;
+}
+
+int FrameGovernor::getLevel() const {
+    return level;
+}
+
+const FrameGovernor::Telemetry& FrameGovernor::getTelemetry() const {
+    return telemetry;
+}
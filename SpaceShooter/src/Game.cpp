@@ -3,24 +3,188 @@
 #include <sstream>
 #include <iomanip>
 #include <random>
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sys/resource.h>
 
-Game::Game() 
-    : window(sf::VideoMode(800, 600), "Space Shooter - Advanced Game Engine")
+namespace {
+    const sf::Color BACKGROUND_COLOR(10, 10, 30); // Dark blue background
+    const sf::Color LETTERBOX_COLOR(0, 0, 0);
+    
+    // Looked up in assets.pak first (make pack stores it under this name)
+    const char* const PATH_FILE = "assets/paths.txt";
+    const char* const FONT_FILE = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+    const float CENTER_X = Playfield::WIDTH / 2.f;
+    
+    // Internal resolution limits (relative to the field's window area)
+    const float MIN_RENDER_SCALE = 0.25f;
+    const float MAX_RENDER_SCALE = 2.f;
+    
+    // Simulation runs in fixed ticks so input can be applied at the tick it happened in
+    const std::int64_t SIM_TICK_US = 1000000 / 120;
+    const int MAX_TICKS_PER_FRAME = 12;
+    const int INPUT_SAMPLE_RATE = 1000;
+    
+    // Allocation test: frames skipped after a (re)start, then frames measured
+    const int ALLOC_TEST_WARMUP_FRAMES = 300;
+    const int ALLOC_TEST_FRAMES = 1800;
+    
+    // Idle menus sleep between event polls (SFML 2's waitEvent has no timeout)
+    const sf::Time IDLE_POLL_INTERVAL = sf::milliseconds(10);
+    const sf::Time IDLE_WAIT_TIMEOUT = sf::milliseconds(250);
+    
+    // User plus system time of the whole process (all threads)
+    double processCpuSeconds() {
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+            + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+    }
+    
+    void reportCpuUsage(std::ostream& out, const char* label, double wallSeconds, double cpuSeconds, int frames) {
+        if (wallSeconds <= 0.0) return;
+        out << "CPU " << label << ": " << std::fixed << std::setprecision(1) << wallSeconds << " s wall, "
+            << std::setprecision(2) << cpuSeconds << " s CPU (" << 100.0 * cpuSeconds / wallSeconds << "%), "
+            << frames << " frames (" << std::setprecision(1) << frames / wallSeconds << " fps)" << std::endl;
+        out.unsetf(std::ios::fixed);
+        out << std::setprecision(6);
+    }
+    
+    // Sets text from an ASCII buffer through scratch. Converting the buffer to a
+    // temporary sf::String would allocate; appending single characters (which
+    // fit the string's inline storage) to a reused string doesn't.
+    void setText(sf::Text& text, sf::String& scratch, const char* ascii) {
+        scratch.clear();
+        for (; *ascii; ++ascii) {
+            scratch += sf::String(*ascii);
+        }
+        text.setString(scratch);
+    }
+}
+
+Game::Game(const GameOptions& opts) 
+    : options(opts)
+    , window(sf::VideoMode(opts.windowWidth, opts.windowHeight), "Space Shooter - Advanced Game Engine")
     , state(GameState::MENU)
-    , score(0)
-    , difficultyLevel(1.f)
-    , enemySpawnTimer(0.f)
-    , enemySpawnInterval(2.f)
-    , menuSelection(0) {
+    , hudScore(-1)
+    , hudHealth(-1)
+    , hudDifficultyTenths(-1)
+    , uiReady(false)
+    , lastWorkTime(0.f)
+    , sceneScale(1.f)
+    , showTelemetry(false)
+    , fireTapped(false)
+    , tickAccumulator(0.f)
+    , simTimeUs(0)
+    , steadyFrames(0)
+    , measuredFrames(0)
+    , framesOverBudget(0)
+    , menuSelection(0)
+    , redraw(true)
+    , lastCpuSeconds(processCpuSeconds()) {
     
     window.setFramerateLimit(60);
+    effectTimers.reserve(ParticleSystem::RESERVE + 16);     // Particle lifetimes plus star spawns
+    particleSystem.attach(effectTimers, Simulation::TICK);
     
-    // Load/create resources
+    fieldBackground.setSize(sf::Vector2f(Playfield::WIDTH, Playfield::HEIGHT));
+    fieldBackground.setFillColor(BACKGROUND_COLOR);
+    resizeView();
+    
+    // Load/create resources (assets.pak is optional, loose files are the fallback)
+    ResourceManager::getInstance().mountPack("assets.pak");
     ResourceManager::getInstance().createProceduralTextures();
     
+    // --software-render: the world is rasterized at field resolution times the render scale
+    if (options.softwareRender) {
+        float scale = std::min(MAX_RENDER_SCALE, std::max(MIN_RENDER_SCALE, options.renderScale));
+        unsigned int width = std::max(1u, static_cast<unsigned int>(Playfield::WIDTH * scale));
+        unsigned int height = std::max(1u, static_cast<unsigned int>(Playfield::HEIGHT * scale));
+        softwareRenderer = std::make_unique<SoftwareRenderer>(width, height);
+        softwareRenderer->setView(Playfield::bounds());
+        for (const char* name : {"player", "enemy", "bullet", "particle", "star"}) {
+            const sf::Texture& texture = ResourceManager::getInstance().getTexture(name);
+            softwareRenderer->addTexture(&texture, texture.copyToImage());
+        }
+        softwareTexture.create(width, height);
+        softwareTexture.setSmooth(true);
+        softwareSprite.setTexture(softwareTexture, true);
+        softwareSprite.setScale(Playfield::WIDTH / width, Playfield::HEIGHT / height);
+    }
+    
+    // Font is decoded in the background so the window shows up immediately
+    fontHandle = ResourceManager::getInstance().loadFontAsync("default", FONT_FILE);
+    
+    // Loading bar shown until the UI font is available
+    loadingBarBack.setSize(sf::Vector2f(300.f, 12.f));
+    loadingBarBack.setFillColor(sf::Color(40, 40, 70));
+    loadingBarBack.setPosition(250.f, 294.f);
+    
+    loadingBarFill.setSize(sf::Vector2f(0.f, 12.f));
+    loadingBarFill.setFillColor(sf::Color::Cyan);
+    loadingBarFill.setPosition(250.f, 294.f);
+    
+    // Every session shares the textures and the enemy movement paths (built-in set if the file is missing)
+    ResourceManager& resources = ResourceManager::getInstance();
+    simConfig.textures.player = &resources.getTexture("player");
+    simConfig.textures.enemy = &resources.getTexture("enemy");
+    simConfig.textures.bullet = &resources.getTexture("bullet");
+    simConfig.masks.player = resources.getMask("player");
+    simConfig.masks.enemy = resources.getMask("enemy");
+    simConfig.masks.bullet = resources.getMask("bullet");
+    std::string pathText;
+    if (resources.readText(PATH_FILE, pathText)) {
+        MovementSystem::readPathText(pathText, PATH_FILE, simConfig.paths);
+    }
+    simConfig.levelPath = options.levelPath;
+    simConfig.fixedPoint = options.fixedPoint;
+    
+    // The allocation test plays by itself
+    if (options.allocationBudget >= 0) {
+        options.autopilot = true;
+        options.trackAllocations = true;
+    }
+    Profiler::setAllocationTracking(options.trackAllocations);
+    
+    // Sounds are synthesized up front; the mixer only reads them afterwards
+    audioBackend = createAudioBackend(options.audioOutput);
+    if (audioBackend) {
+        audio.createSounds();
+        if (!audioBackend->start(audio)) {
+            audioBackend.reset();
+        }
+    }
+    
+    if (!options.capturePath.empty()) {
+        unsigned int width = static_cast<unsigned int>(Playfield::WIDTH);
+        unsigned int height = static_cast<unsigned int>(Playfield::HEIGHT);
+        if (captureTarget.create(width, height)) {
+            captureTarget.setView(sf::View(Playfield::bounds()));
+            captureTarget.setSmooth(true);
+            captureSprite.setTexture(captureTarget.getTexture(), true);
+            frameCapture.start(captureTarget, options.captureFormat, options.capturePath);
+        } else {
+            std::cerr << "Failed to create capture target, not recording" << std::endl;
+        }
+    }
+    
+    if (!options.metricsAddress.empty()) {
+        metrics = std::make_unique<EngineMetrics>();
+        metricsServer = std::make_unique<MetricsServer>(metrics->registry);
+        if (metricsServer->start(options.metricsAddress)) {
+            std::cout << "Metrics: " << metricsServer->getUrl() << std::endl;
+        } else {
+            metricsServer.reset();
+            metrics.reset();
+        }
+    }
+}
+
+void Game::setupUI() {
     // Setup fonts (using default font if file not available)
-    sf::Font& font = ResourceManager::getInstance().loadFont("default", 
-        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf");
+    sf::Font& font = ResourceManager::getInstance().getFont("default");
     
     // Setup UI texts
     scoreText.setFont(font);
@@ -45,7 +209,7 @@ Game::Game()
     menuTitle.setString("SPACE SHOOTER");
     sf::FloatRect titleBounds = menuTitle.getLocalBounds();
     menuTitle.setOrigin(titleBounds.width / 2.f, titleBounds.height / 2.f);
-    menuTitle.setPosition(400.f, 150.f);
+    menuTitle.setPosition(CENTER_X, 150.f);
     
     menuStart.setFont(font);
     menuStart.setCharacterSize(30);
@@ -53,7 +217,7 @@ Game::Game()
     menuStart.setString("> START GAME");
     sf::FloatRect startBounds = menuStart.getLocalBounds();
     menuStart.setOrigin(startBounds.width / 2.f, startBounds.height / 2.f);
-    menuStart.setPosition(400.f, 300.f);
+    menuStart.setPosition(CENTER_X, 300.f);
     
     menuExit.setFont(font);
     menuExit.setCharacterSize(30);
@@ -61,7 +225,7 @@ Game::Game()
     menuExit.setString("  EXIT");
     sf::FloatRect exitBounds = menuExit.getLocalBounds();
     menuExit.setOrigin(exitBounds.width / 2.f, exitBounds.height / 2.f);
-    menuExit.setPosition(400.f, 360.f);
+    menuExit.setPosition(CENTER_X, 360.f);
     
     // Game Over texts
     gameOverText.setFont(font);
@@ -70,7 +234,7 @@ Game::Game()
     gameOverText.setString("GAME OVER");
     sf::FloatRect govrBounds = gameOverText.getLocalBounds();
     gameOverText.setOrigin(govrBounds.width / 2.f, govrBounds.height / 2.f);
-    gameOverText.setPosition(400.f, 200.f);
+    gameOverText.setPosition(CENTER_X, 200.f);
     
     finalScoreText.setFont(font);
     finalScoreText.setCharacterSize(30);
@@ -83,77 +247,314 @@ Game::Game()
     restartText.setString("Press SPACE to return to menu");
     sf::FloatRect restartBounds = restartText.getLocalBounds();
     restartText.setOrigin(restartBounds.width / 2.f, restartBounds.height / 2.f);
-    restartText.setPosition(400.f, 400.f);
+    restartText.setPosition(CENTER_X, 400.f);
+    
+    telemetryText.setFont(font);
+    telemetryText.setCharacterSize(14);
+    telemetryText.setFillColor(sf::Color(150, 200, 255));
+    telemetryText.setPosition(Playfield::WIDTH - 240.f, 10.f);
+    
+    uiReady = true;
+    updateMenu();
 }
 
-void Game::run() {
+int Game::run() {
     while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
+        // Menu and game over wait for input instead of drawing the same frame 60 times a second
+        if (isIdle()) {
+            waitForInput();
+            continue;
+        }
+        
+        float frameTime = clock.restart().asSeconds();
+        
+        if (state == GameState::PLAYING) {
+            updateGovernor(frameTime);
+        }
         
         // Cap delta time to prevent huge jumps
-        if (dt > 0.1f) dt = 0.1f;
+        float dt = frameTime > 0.1f ? 0.1f : frameTime;
         
-        processEvents();
-        update(dt);
-        render();
+        {
+            ProfileZone zone("assets");
+            ResourceManager::getInstance().processAsyncLoads();
+        }
+        
+        {
+            ProfileZone zone("events");
+            
+            // Without the sampler thread input is only seen once per frame
+            if (options.legacyInput) {
+                inputSampler.sampleOnce();
+            }
+            
+            processEvents();
+        }
+        
+        {
+            ProfileZone zone("update");
+            update(dt);
+        }
+        
+        // Offline mixing keeps pace with real time here; a device pulls on its own thread
+        if (audioBackend) {
+            ProfileZone zone("audio");
+            audioBackend->update(frameTime);
+        }
+        
+        {
+            ProfileZone zone("render");
+            render();
+        }
+        
+        if (options.measureLatency) {
+            recordLatency();
+        }
+        
+        if (options.trackAllocations) {
+            checkAllocations(Profiler::endFrame());
+        }
+        
+        if (options.reportCpu) {
+            accountCpu(state != GameState::PLAYING, true);
+        }
+        
+        if (metrics && state == GameState::PLAYING) {
+            metrics->recordFrame(frameTime, simulation.get(), particleSystem.getLiveCount());
+        }
+    }
+    
+    if (metricsServer) {
+        metricsServer->stop();
+        std::cout << "Metrics: served " << metricsServer->getScrapes() << " scrapes" << std::endl;
+    }
+    
+    if (options.measureLatency) {
+        latencyMeter.report(std::cout, options.legacyInput ? "per-frame input" : "sampler input");
+    }
+    
+    if (options.reportCpu) {
+        reportCpuUsage(std::cout, "menu/game over", menuUsage.wallSeconds, menuUsage.cpuSeconds, menuUsage.frames);
+        reportCpuUsage(std::cout, "gameplay", playUsage.wallSeconds, playUsage.cpuSeconds, playUsage.frames);
+    }
+    
+    if (audioBackend) {
+        audioBackend->stop();
+        if (options.audioOutput == AudioOutput::OFFLINE) {
+            audio.report(std::cout);
+        }
+    }
+    
+    if (frameCapture.isRunning()) {
+        frameCapture.stop();
+        frameCapture.report(std::cout);
+    }
+    
+    if (options.autopilot) {
+        const AutopilotInput::DecisionStats& d = autopilot.getStats();
+        std::cout << "Autopilot: " << d.decisions << " decisions, mean " << d.meanUs() 
+                  << " us, max " << d.maxNs / 1000.0 << " us" << std::endl;
+    }
+    
+    if (options.allocationBudget >= 0) {
+        bool passed = measuredFrames > 0 && framesOverBudget == 0;
+        std::cout << "Allocation test " << (passed ? "PASSED" : "FAILED") << ": " << framesOverBudget << " of " 
+                  << measuredFrames << " steady-state frames over the budget of " << options.allocationBudget 
+                  << " allocations" << std::endl;
+        std::cout << "Worst frame:" << std::endl;
+        Profiler::report(std::cout, worstFrame);
+        return passed ? 0 : 1;
+    }
+    
+    if (options.trackAllocations) {
+        std::cout << "Worst frame allocations:" << std::endl;
+        Profiler::report(std::cout, worstFrame);
+    }
+    return 0;
+}
+
+void Game::checkAllocations(const Profiler::Frame& frame) {
+    // Only gameplay frames past the warm-up count as steady state
+    if (state != GameState::PLAYING) {
+        steadyFrames = 0;
+        
+        // The test restarts right away after a game over (and starts once loading is done)
+        if (options.allocationBudget >= 0 && uiReady) {
+            if (state == GameState::GAME_OVER) {
+                resetGame();
+            }
+            startGame();
+        }
+        return;
+    }
+    
+    if (++steadyFrames <= ALLOC_TEST_WARMUP_FRAMES) {
+        return;
+    }
+    
+    ++measuredFrames;
+    if (frame.allocations > worstFrame.allocations || measuredFrames == 1) {
+        worstFrame = frame;
+    }
+    if (options.allocationBudget >= 0) {
+        if (frame.allocations > static_cast<std::uint64_t>(options.allocationBudget)) {
+            ++framesOverBudget;
+        }
+        if (measuredFrames >= ALLOC_TEST_FRAMES) {
+            window.close();
+        }
+    }
+}
+
+void Game::recordLatency() {
+    // Called right after display(): the frame that reflects these inputs was just presented
+    std::int64_t presented = InputSampler::now();
+    for (std::int64_t sampled : frameInputTimes) {
+        latencyMeter.addSample(presented - sampled);
+    }
+    frameInputTimes.clear();
+    
+    if (latencyReportClock.getElapsedTime().asSeconds() >= 5.f && latencyMeter.getSampleCount() > 0) {
+        latencyMeter.report(std::cout, options.legacyInput ? "per-frame input" : "sampler input");
+        latencyReportClock.restart();
     }
 }
 
 void Game::processEvents() {
     sf::Event event;
     while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) {
-            window.close();
-        }
-        
-        if (state == GameState::MENU) {
-            if (event.type == sf::Event::KeyPressed) {
-                if (event.key.code == sf::Keyboard::Up || event.key.code == sf::Keyboard::W) {
-                    menuSelection = 0;
-                }
-                if (event.key.code == sf::Keyboard::Down || event.key.code == sf::Keyboard::S) {
-                    menuSelection = 1;
-                }
-                if (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Space) {
-                    if (menuSelection == 0) {
-                        startGame();
-                    } else {
-                        window.close();
-                    }
-                }
+        handleEvent(event);
+    }
+}
+
+void Game::handleEvent(const sf::Event& event) {
+    if (event.type == sf::Event::Closed) {
+        window.close();
+    }
+    
+    if (event.type == sf::Event::Resized) {
+        resizeView();
+        redraw = true;
+    }
+    
+    // The window contents may have been lost while covered
+    if (event.type == sf::Event::GainedFocus) {
+        redraw = true;
+    }
+    
+    // Only the loading bar shows until the UI is set up; the menu isn't there to pick from
+    if (state == GameState::MENU && uiReady) {
+        if (event.type == sf::Event::KeyPressed) {
+            int selection = menuSelection;
+            if (event.key.code == sf::Keyboard::Up || event.key.code == sf::Keyboard::W) {
+                selection = 0;
             }
-        }
-        
-        if (state == GameState::PLAYING) {
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
-                if (player && player->canShoot()) {
-                    sf::Vector2f pos = player->getPosition();
-                    bullets.push_back(std::make_unique<Bullet>(pos.x, pos.y - 20));
-                    player->resetShootTimer();
+            if (event.key.code == sf::Keyboard::Down || event.key.code == sf::Keyboard::S) {
+                selection = 1;
+            }
+            if (selection != menuSelection) {
+                menuSelection = selection;
+                updateMenu();
+            }
+            if (event.key.code == sf::Keyboard::Enter || event.key.code == sf::Keyboard::Space) {
+                if (menuSelection == 0) {
+                    startGame();
+                } else {
+                    window.close();
                 }
             }
         }
+    }
+    
+    if (state == GameState::PLAYING) {
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            showTelemetry = !showTelemetry;
+        }
         
-        if (state == GameState::GAME_OVER) {
-            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
-                state = GameState::MENU;
-                resetGame();
-            }
+    }
+    
+    if (state == GameState::GAME_OVER) {
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) {
+            state = GameState::MENU;
+            resetGame();
+        }
+    }
+}
+
+bool Game::isIdle() const {
+    // The loading bar animates; capture and the allocation test want every frame
+    return options.idleRendering && state != GameState::PLAYING && uiReady
+        && !frameCapture.isRunning() && options.allocationBudget < 0;
+}
+
+void Game::waitForInput() {
+    // The sampler thread only feeds gameplay; startGame() restarts it
+    if (inputSampler.isRunning()) {
+        inputSampler.stop();
+    }
+    
+    sf::Event event;
+    if (waitForEvent(event, IDLE_WAIT_TIMEOUT)) {
+        handleEvent(event);
+        processEvents();
+    }
+    ResourceManager::getInstance().processAsyncLoads();
+    
+    bool rendered = redraw && window.isOpen();
+    if (rendered) {
+        render();
+        redraw = false;
+    }
+    
+    if (options.reportCpu) {
+        accountCpu(true, rendered);
+    }
+    
+    // Time spent waiting isn't frame time for the first frame after it
+    clock.restart();
+}
+
+bool Game::waitForEvent(sf::Event& event, sf::Time timeout) {
+    // Short sleeps keep the process off the CPU and still notice input within one interval
+    sf::Clock waited;
+    while (!window.pollEvent(event)) {
+        if (waited.getElapsedTime() >= timeout) {
+            return false;
         }
+        sf::sleep(IDLE_POLL_INTERVAL);
+    }
+    return true;
+}
+
+void Game::accountCpu(bool menu, bool rendered) {
+    double cpu = processCpuSeconds();
+    CpuUsage& usage = menu ? menuUsage : playUsage;
+    usage.wallSeconds += usageClock.restart().asSeconds();
+    usage.cpuSeconds += cpu - lastCpuSeconds;
+    if (rendered) {
+        ++usage.frames;
     }
+    lastCpuSeconds = cpu;
 }
 
 void Game::update(float dt) {
-    switch (state) {
-        case GameState::MENU:
-            updateMenu();
-            break;
-        case GameState::PLAYING:
-            updatePlaying(dt);
-            break;
-        case GameState::GAME_OVER:
-            updateGameOver();
-            break;
+    if (!uiReady) {
+        if (ResourceManager::getInstance().isReady(fontHandle)) {
+            setupUI();
+        } else {
+            float progress = ResourceManager::getInstance().getLoadingProgress();
+            loadingBarFill.setSize(sf::Vector2f(300.f * progress, 12.f));
+        }
+    }
+    
+    // Input is only consumed by gameplay
+    if (state != GameState::PLAYING) {
+        inputSampler.discardPending();
+    }
+    
+    // Menu and game over texts change with input and state (updateMenu, updateGameOver)
+    if (state == GameState::PLAYING) {
+        advanceSimulation(dt);
     }
 }
 
@@ -177,223 +578,405 @@ void Game::updateMenu() {
     
     sf::FloatRect exitBounds = menuExit.getLocalBounds();
     menuExit.setOrigin(exitBounds.width / 2.f, exitBounds.height / 2.f);
+    redraw = true;
+}
+
+void Game::advanceSimulation(float dt) {
+    tickAccumulator += dt;
+    
+    int ticks = 0;
+    while (tickAccumulator >= Simulation::TICK && state == GameState::PLAYING) {
+        simTimeUs += SIM_TICK_US;
+        applyInputEvents(simTimeUs);
+        updatePlaying(Simulation::TICK);
+        tickAccumulator -= Simulation::TICK;
+        
+        // Drop the backlog instead of spiralling when far behind
+        if (++ticks >= MAX_TICKS_PER_FRAME) {
+            tickAccumulator = 0.f;
+            break;
+        }
+    }
+    
+    // Keep the tick clock close to the sampler clock after stalls
+    std::int64_t now = InputSampler::now();
+    if (now - simTimeUs > 100000) {
+        simTimeUs = now - SIM_TICK_US;
+    }
+    
+    updateHud();
+}
+
+void Game::applyInputEvents(std::int64_t tickEndUs) {
+    // Apply every edge sampled before the end of this tick; later ones wait for their tick
+    const InputEvent* event = inputSampler.peek();
+    while (event && event->timestampUs <= tickEndUs) {
+        playerInput.apply(*event);
+        if (event->action == InputAction::FIRE && event->pressed) {
+            fireTapped = true;
+        }
+        if (options.measureLatency && event->pressed) {
+            frameInputTimes.push_back(event->timestampUs);
+        }
+        
+        InputEvent consumed;
+        inputSampler.pop(consumed);
+        event = inputSampler.peek();
+    }
 }
 
 void Game::updatePlaying(float dt) {
+    // Effect timers (star spawns, particle lifetimes) tick with the simulation
+    effectTimers.advance();
+    
     // Update background
     background.update(dt);
     
-    // Update player
-    if (player) {
-        player->update(dt);
-        
-        if (!player->isAlive()) {
-            gameOver();
-        }
+    // Taps shorter than a tick still fire
+    PlayerInput tickInput = playerInput;
+    tickInput.fire = playerInput.fire || fireTapped;
+    fireTapped = false;
+    
+    if (options.autopilot) {
+        tickInput = autopilot.nextInput(*simulation);
     }
     
-    // Update bullets
-    for (auto& bullet : bullets) {
-        bullet->update(dt);
+    {
+        ProfileZone zone("simulation");
+        simulation->step(tickInput);
     }
     
-    // Update enemies
-    for (auto& enemy : enemies) {
-        enemy->update(dt);
+    if (metrics) {
+        metrics->recordTick(*simulation);
     }
     
-    // Update particles
-    particleSystem.update(dt);
+    // Effects for what happened this tick, then update particles
+    {
+        ProfileZone zone("particles");
+        spawnEffects(simulation->getEvents());
+        particleSystem.update(dt);
+    }
     
-    // Spawn enemies
-    enemySpawnTimer += dt;
-    if (enemySpawnTimer >= enemySpawnInterval) {
-        spawnEnemy();
-        enemySpawnTimer = 0.f;
+    if (audioBackend) {
+        ProfileZone zone("audio");
+        playSounds(simulation->getEvents());
     }
     
-    // Check collisions
-    checkCollisions();
+    if (simulation->isOver()) {
+        gameOver();
+    }
+}
+
+void Game::spawnEffects(const GameEventQueue& events) {
+    for (const GameEvent& event : events) {
+        switch (event.type) {
+            case GameEventType::ENEMY_DESTROYED:
+                particleSystem.createExplosion(event.x, event.y, 25);
+                break;
+            case GameEventType::PLAYER_RAMMED:
+                particleSystem.createExplosion(event.x, event.y, 15);
+                break;
+            case GameEventType::PLAYER_SHOT:
+                particleSystem.createExplosion(event.x, event.y, 5);
+                break;
+            case GameEventType::PLAYER_FIRED:
+            case GameEventType::ENEMY_FIRED:
+                break;
+        }
+    }
+}
+
+void Game::playSounds(const GameEventQueue& events) {
+    // Gain and panning are relative to the player
+    sf::Vector2f listener = simulation->getPlayer().getPosition();
+    audio.setListener(listener.x, listener.y);
+    
+    for (const GameEvent& event : events) {
+        switch (event.type) {
+            case GameEventType::ENEMY_DESTROYED:
+                audio.play(SoundId::EXPLOSION, event.x, event.y);
+                break;
+            case GameEventType::PLAYER_RAMMED:
+                audio.play(SoundId::EXPLOSION, event.x, event.y);
+                audio.play(SoundId::PLAYER_HIT, event.x, event.y);
+                break;
+            case GameEventType::PLAYER_SHOT:
+                audio.play(SoundId::PLAYER_HIT, event.x, event.y);
+                break;
+            case GameEventType::PLAYER_FIRED:
+                audio.play(SoundId::PLAYER_SHOT, event.x, event.y);
+                break;
+            case GameEventType::ENEMY_FIRED:
+                audio.play(SoundId::ENEMY_SHOT, event.x, event.y);
+                break;
+        }
+    }
+}
+
+void Game::updateHud() {
+    ProfileZone zone("hud");
+    
+    // Texts are only rebuilt when their value changes (formatting them through a
+    // stringstream every frame was the HUD's steady per-frame allocation)
+    char buffer[64];
+    int score = simulation->getScore();
+    if (score != hudScore) {
+        hudScore = score;
+        std::snprintf(buffer, sizeof(buffer), "Score: %d", score);
+        setText(scoreText, hudString, buffer);
+    }
     
-    // Cleanup inactive entities
-    cleanupEntities();
+    const Player& player = simulation->getPlayer();
+    if (player.getHealth() != hudHealth) {
+        hudHealth = player.getHealth();
+        std::snprintf(buffer, sizeof(buffer), "Health: %d/%d", player.getHealth(), player.getMaxHealth());
+        setText(healthText, hudString, buffer);
+    }
     
-    // Update difficulty based on score
-    difficultyLevel = 1.f + (score / 100.f) * 0.5f;
-    enemySpawnInterval = std::max(0.5f, 2.f / difficultyLevel);
+    int difficultyTenths = static_cast<int>(std::lround(simulation->getDifficulty() * 10.f));
+    if (difficultyTenths != hudDifficultyTenths) {
+        hudDifficultyTenths = difficultyTenths;
+        std::snprintf(buffer, sizeof(buffer), "Difficulty: %d.%dx", difficultyTenths / 10, difficultyTenths % 10);
+        setText(difficultyText, hudString, buffer);
+    }
     
-    // Update UI
-    std::stringstream ss;
-    ss << "Score: " << score;
-    scoreText.setString(ss.str());
+    if (showTelemetry) {
+        const FrameGovernor::Telemetry& t = governor.getTelemetry();
+        std::stringstream ss;
+        ss << std::fixed << "Frame: " << std::setprecision(2) << t.frameTimeMs << " ms (work " << t.workTimeMs 
+           << " / " << t.budgetMs << ")\n"
+           << "Quality: " << t.level << "  particles x" << t.particleScale << "\n"
+           << "Stars: " << t.starLimit << "  scale " << t.renderScale << "\n"
+           << "Down/up: " << t.downgrades << "/" << t.upgrades;
+        if (options.autopilot) {
+            const AutopilotInput::DecisionStats& d = autopilot.getStats();
+            ss << "\nAutopilot: " << d.meanUs() << " us (max " << d.maxNs / 1000.0 << ")";
+        }
+        if (options.trackAllocations) {
+            const Profiler::Frame& f = Profiler::getLastFrame();
+            ss << "\nAllocs: " << f.allocations << " (" << f.bytes << " bytes)";
+        }
+        telemetryText.setString(ss.str());
+    }
+}
+
+void Game::updateGovernor(float frameTime) {
+    if (!governor.recordFrame(frameTime, lastWorkTime)) {
+        return;
+    }
+    
+    applyQuality();
     
-    if (player) {
-        ss.str("");
-        ss << "Health: " << player->getHealth() << "/" << player->getMaxHealth();
-        healthText.setString(ss.str());
+    // Level changes are also on the F3 overlay; --governor-log prints them as they happen
+    if (!options.logGovernor) {
+        return;
+    }
+    const FrameGovernor::Telemetry& t = governor.getTelemetry();
+    std::cout << "[governor] level " << t.level 
+              << " frame " << t.frameTimeMs << "ms work " << t.workTimeMs << "ms"
+              << " -> particles x" << t.particleScale 
+              << ", stars " << t.starLimit 
+              << ", render scale " << t.renderScale << std::endl;
+}
+
+void Game::applyQuality() {
+    particleSystem.setEmissionScale(governor.getParticleScale());
+    background.setStarLimit(governor.getStarLimit());
+    applyRenderScale(governor.getRenderScale());
+}
+
+void Game::applyRenderScale(float scale) {
+    float effective = std::min(MAX_RENDER_SCALE, std::max(MIN_RENDER_SCALE, options.renderScale * scale));
+    if (effective == sceneScale) return;
+    
+    sceneScale = 1.f;
+    if (effective == 1.f) return;  // Native resolution draws straight to the window
+    
+    // Same logical coordinates at a different pixel count; resampled with filtering on present
+    sf::Vector2u pixels = Playfield::viewportPixels(window.getSize());
+    unsigned int width = std::max(1u, static_cast<unsigned int>(pixels.x * effective));
+    unsigned int height = std::max(1u, static_cast<unsigned int>(pixels.y * effective));
+    if (!sceneTarget.create(width, height)) {
+        std::cerr << "Failed to create scene target, keeping native resolution" << std::endl;
+        return;
     }
     
-    ss.str("");
-    ss << "Difficulty: " << std::fixed << std::setprecision(1) << difficultyLevel << "x";
-    difficultyText.setString(ss.str());
+    sceneTarget.setView(sf::View(Playfield::bounds()));
+    sceneTarget.setSmooth(true);
+    sceneSprite.setTexture(sceneTarget.getTexture(), true);
+    sceneSprite.setScale(Playfield::WIDTH / width, Playfield::HEIGHT / height);
+    sceneScale = effective;
+}
+
+void Game::resizeView() {
+    // Field coordinates stay fixed; the window only changes how many pixels they cover
+    fieldView = Playfield::letterboxView(window.getSize());
+    window.setView(fieldView);
+    
+    // Rebuild the scene target for the new pixel size
+    sceneScale = 0.f;
+    applyRenderScale(governor.getRenderScale());
 }
 
 void Game::updateGameOver() {
     std::stringstream ss;
-    ss << "Final Score: " << score;
+    ss << "Final Score: " << (simulation ? simulation->getScore() : 0);
     finalScoreText.setString(ss.str());
     
     sf::FloatRect bounds = finalScoreText.getLocalBounds();
     finalScoreText.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
-    finalScoreText.setPosition(400.f, 300.f);
+    finalScoreText.setPosition(CENTER_X, 300.f);
 }
 
 void Game::render() {
-    window.clear(sf::Color(10, 10, 30)); // Dark blue background
+    // While recording, the whole frame goes to the capture target first
+    bool capturing = frameCapture.isRunning();
+    sf::RenderTarget& frame = capturing ? static_cast<sf::RenderTarget&>(captureTarget) : window;
+    
+    // Bars outside the field, then the field itself
+    window.clear(LETTERBOX_COLOR);
+    frame.draw(fieldBackground);
     
     switch (state) {
         case GameState::MENU:
-            renderMenu();
+            renderMenu(frame);
             break;
         case GameState::PLAYING:
-            renderPlaying();
+            renderPlaying(frame);
             break;
         case GameState::GAME_OVER:
-            renderGameOver();
+            renderGameOver(frame);
             break;
     }
     
+    if (capturing) {
+        captureTarget.display();
+        {
+            ProfileZone zone("capture");
+            frameCapture.capture();
+        }
+        window.draw(captureSprite);
+    }
+    
+    // Time spent before the limiter/vsync wait inside display()
+    lastWorkTime = clock.getElapsedTime().asSeconds();
     window.display();
 }
 
-void Game::renderMenu() {
-    window.draw(menuTitle);
-    window.draw(menuStart);
-    window.draw(menuExit);
-}
-
-void Game::renderPlaying() {
-    // Render background
-    background.render(window);
-    
-    // Render player
-    if (player) {
-        player->render(window);
+void Game::renderMenu(sf::RenderTarget& frame) {
+    if (!uiReady) {
+        renderLoading(frame);
+        return;
     }
     
-    // Render bullets
-    for (auto& bullet : bullets) {
-        bullet->render(window);
-    }
-    
-    // Render enemies
-    for (auto& enemy : enemies) {
-        enemy->render(window);
-    }
-    
-    // Render particles
-    particleSystem.render(window);
-    
-    // Render UI
-    window.draw(scoreText);
-    window.draw(healthText);
-    window.draw(difficultyText);
+    frame.draw(menuTitle);
+    frame.draw(menuStart);
+    frame.draw(menuExit);
 }
 
-void Game::renderGameOver() {
-    window.draw(gameOverText);
-    window.draw(finalScoreText);
-    window.draw(restartText);
+void Game::renderLoading(sf::RenderTarget& frame) {
+    frame.draw(loadingBarBack);
+    frame.draw(loadingBarFill);
 }
 
-void Game::spawnEnemy() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> posX(50.f, 750.f);
+void Game::renderPlaying(sf::RenderTarget& frame) {
+    // World goes to the software rasterizer, or to the scaled target unless it
+    // renders at native resolution
+    bool scaled = sceneScale != 1.f;
+    RenderBackend* world = &worldBackend;
+    if (softwareRenderer) {
+        softwareRenderer->clear(BACKGROUND_COLOR);
+        world = softwareRenderer.get();
+    } else if (scaled) {
+        sceneTarget.clear(BACKGROUND_COLOR);
+        worldBackend.setTarget(sceneTarget);
+    } else {
+        worldBackend.setTarget(frame);
+    }
     
-    enemies.push_back(std::make_unique<Enemy>(posX(gen), -30.f, difficultyLevel));
-}
-
-void Game::checkCollisions() {
-    if (!player) return;
+    // Render background
+    background.render(*world);
     
-    // Bullet vs Enemy collisions
-    for (auto& bullet : bullets) {
-        if (!bullet->isActive()) continue;
-        
-        for (auto& enemy : enemies) {
-            if (!enemy->isActive()) continue;
-            
-            if (bullet->getBounds().intersects(enemy->getBounds())) {
-                // Collision detected!
-                bullet->setActive(false);
-                enemy->setActive(false);
-                
-                // Increase score
-                score += enemy->getScoreValue();
-                
-                // Create explosion effect
-                sf::Vector2f pos = enemy->getPosition();
-                particleSystem.createExplosion(pos.x, pos.y, 25);
-            }
+    // Render player, bullets, enemies and enemy projectiles
+    simulation->render(*world);
+    
+    // Render particles
+    particleSystem.render(*world);
+    
+    if (softwareRenderer) {
+        {
+            ProfileZone zone("rasterize");
+            softwareRenderer->finish();
         }
+        softwareTexture.update(softwareRenderer->getPixels());
+        frame.draw(softwareSprite);
+    } else if (scaled) {
+        sceneTarget.display();
+        frame.draw(sceneSprite);
     }
     
-    // Enemy vs Player collisions
-    for (auto& enemy : enemies) {
-        if (!enemy->isActive()) continue;
-        
-        if (player->getBounds().intersects(enemy->getBounds())) {
-            enemy->setActive(false);
-            player->takeDamage(20);
-            
-            // Create explosion
-            sf::Vector2f pos = enemy->getPosition();
-            particleSystem.createExplosion(pos.x, pos.y, 15);
-        }
+    // Render UI (always native resolution)
+    frame.draw(scoreText);
+    frame.draw(healthText);
+    frame.draw(difficultyText);
+    
+    if (showTelemetry) {
+        frame.draw(telemetryText);
     }
 }
 
-void Game::cleanupEntities() {
-    // Remove inactive bullets
-    bullets.erase(
-        std::remove_if(bullets.begin(), bullets.end(),
-            [](const std::unique_ptr<Bullet>& b) { return !b->isActive(); }),
-        bullets.end()
-    );
-    
-    // Remove inactive enemies
-    enemies.erase(
-        std::remove_if(enemies.begin(), enemies.end(),
-            [](const std::unique_ptr<Enemy>& e) { return !e->isActive(); }),
-        enemies.end()
-    );
+void Game::renderGameOver(sf::RenderTarget& frame) {
+    frame.draw(gameOverText);
+    frame.draw(finalScoreText);
+    frame.draw(restartText);
 }
 
 void Game::startGame() {
     state = GameState::PLAYING;
     
-    // Create player
-    player = std::make_unique<Player>();
-    player->setPosition(400.f, 500.f);
+    // New session with a fresh seed
+    static std::random_device rd;
+    simConfig.seed = rd();
+    simulation = std::make_unique<Simulation>(simConfig);
     
-    // Reset game stats
-    score = 0;
-    difficultyLevel = 1.f;
-    enemySpawnTimer = 0.f;
-    enemySpawnInterval = 2.f;
+    // Effect timers restart with the session's tick clock
+    particleSystem.clear();
+    effectTimers.clear();
+    background.attach(effectTimers, Simulation::TICK);
+    
+    governor.reset();
+    applyQuality();
+    hudScore = hudHealth = hudDifficultyTenths = -1;
+    if (metrics) {
+        metrics->startSession();
+    }
+    
+    // Fresh input state; the tick clock starts now
+    playerInput = PlayerInput();
+    fireTapped = false;
+    if (!options.legacyInput && !inputSampler.isRunning()) {
+        inputSampler.start(INPUT_SAMPLE_RATE);
+    }
+    inputSampler.discardPending();
+    inputSampler.resync();          // Keys held into the new game count as pressed
+    tickAccumulator = 0.f;
+    simTimeUs = InputSampler::now();
 }
 
 void Game::gameOver() {
     state = GameState::GAME_OVER;
+    if (metrics) {
+        metrics->endSession(simulation->getScore());
+    }
+    updateGameOver();
+    redraw = true;
 }
 
 void Game::resetGame() {
-    // Clear all entities
-    player.reset();
-    bullets.clear();
-    enemies.clear();
+    // Back to the menu: drop the session and effects
+    simulation.reset();
     particleSystem.clear();
     
     menuSelection = 0;
+    updateMenu();
 }
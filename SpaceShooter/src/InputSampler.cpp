@@ -0,0 +1,129 @@
+#include "InputSampler.h"
+#include <SFML/Window/Keyboard.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+void PlayerInput::apply(const InputEvent& event) {
+    switch (event.action) {
+        case InputAction::UP:    up = event.pressed; break;
+        case InputAction::DOWN:  down = event.pressed; break;
+        case InputAction::LEFT:  left = event.pressed; break;
+        case InputAction::RIGHT: right = event.pressed; break;
+        case InputAction::FIRE:  fire = event.pressed; break;
+        case InputAction::COUNT: break;
+    }
+}
+
+namespace {
+    // WASD or arrow keys, Space to shoot
+    bool isActionPressed(InputAction action) {
+        switch (action) {
+            case InputAction::UP:
+                return sf::Keyboard::isKeyPressed(sf::Keyboard::W) || sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+            case InputAction::DOWN:
+                return sf::Keyboard::isKeyPressed(sf::Keyboard::S) || sf::Keyboard::isKeyPressed(sf::Keyboard::Down);
+            case InputAction::LEFT:
+                return sf::Keyboard::isKeyPressed(sf::Keyboard::A) || sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+            case InputAction::RIGHT:
+                return sf::Keyboard::isKeyPressed(sf::Keyboard::D) || sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+            case InputAction::FIRE:
+                return sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+            case InputAction::COUNT:
+                break;
+        }
+        return false;
+    }
+}
+
+InputSampler::InputSampler() : held(), running(false), droppedEvents(0), resyncRequested(false), rateHz(0) {}
+
+InputSampler::~InputSampler() {
+    stop();
+}
+
+void InputSampler::start(int hz) {
+    if (running) return;
+
+    rateHz = hz;
+    std::fill(std::begin(held), std::end(held), false);
+    resyncRequested = false;
+    running = true;
+    thread = std::thread(&InputSampler::samplerLoop, this);
+}
+
+void InputSampler::stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool InputSampler::isRunning() const {
+    return running;
+}
+
+int InputSampler::getRate() const {
+    return rateHz;
+}
+
+void InputSampler::samplerLoop() {
+    auto period = std::chrono::microseconds(1000000 / rateHz);
+    auto next = std::chrono::steady_clock::now();
+
+    while (running) {
+        sampleOnce();
+
+        // Absolute deadlines keep the rate stable regardless of polling cost
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void InputSampler::sampleOnce() {
+    std::int64_t timestamp = now();
+
+    // held[] belongs to the sampling thread, so resync() only flags it
+    if (resyncRequested.load(std::memory_order_relaxed) && resyncRequested.exchange(false)) {
+        std::fill(std::begin(held), std::end(held), false);
+    }
+
+    for (int i = 0; i < static_cast<int>(InputAction::COUNT); ++i) {
+        InputAction action = static_cast<InputAction>(i);
+        bool pressed = isActionPressed(action);
+        if (pressed == held[i]) continue;
+
+        // A dropped edge is retried on the next sample instead of being lost
+        if (events.push(InputEvent{timestamp, action, pressed})) {
+            held[i] = pressed;
+        } else {
+            ++droppedEvents;
+        }
+    }
+}
+
+const InputEvent* InputSampler::peek() const {
+    return events.peek();
+}
+
+bool InputSampler::pop(InputEvent& event) {
+    return events.pop(event);
+}
+
+void InputSampler::discardPending() {
+    InputEvent event;
+    while (events.pop(event)) {}
+}
+
+void InputSampler::resync() {
+    resyncRequested = true;
+}
+
+unsigned int InputSampler::getDroppedEvents() const {
+    return droppedEvents;
+}
+
+std::int64_t InputSampler::now() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
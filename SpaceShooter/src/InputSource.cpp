@@ -0,0 +1,27 @@
+#include "InputSource.h"
+#include "Simulation.h"
+
+ScriptedInput::ScriptedInput(std::uint32_t seed)
+    : rng(seed)
+    , ticksLeft(0) {
+    current.fire = true;
+}
+
+PlayerInput ScriptedInput::nextInput(const Simulation& simulation) {
+    (void)simulation;
+
+    if (--ticksLeft <= 0) {
+        // New direction every 0.1 - 0.5 seconds
+        std::uniform_int_distribution<int> hold(12, 60);
+        std::uniform_int_distribution<int> axis(-1, 1);
+        int dx = axis(rng);
+        int dy = axis(rng);
+        current.left = dx < 0;
+        current.right = dx > 0;
+        current.up = dy < 0;
+        current.down = dy > 0;
+        ticksLeft = hold(rng);
+    }
+
+    return current;
+}
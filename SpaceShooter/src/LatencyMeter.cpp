@@ -0,0 +1,53 @@
+#include "LatencyMeter.h"
+#include <iomanip>
+
+LatencyMeter::LatencyMeter() : buckets(BUCKET_COUNT, 0), sampleCount(0), totalUs(0), maxUs(0) {}
+
+void LatencyMeter::addSample(std::int64_t latencyUs) {
+    if (latencyUs < 0) latencyUs = 0;
+
+    std::int64_t bucket = latencyUs / BUCKET_US;
+    if (bucket >= BUCKET_COUNT) bucket = BUCKET_COUNT - 1;
+    ++buckets[static_cast<std::size_t>(bucket)];
+
+    ++sampleCount;
+    totalUs += latencyUs;
+    if (latencyUs > maxUs) maxUs = latencyUs;
+}
+
+void LatencyMeter::reset() {
+    buckets.assign(BUCKET_COUNT, 0);
+    sampleCount = 0;
+    totalUs = 0;
+    maxUs = 0;
+}
+
+unsigned int LatencyMeter::getSampleCount() const {
+    return sampleCount;
+}
+
+std::int64_t LatencyMeter::percentile(float fraction) const {
+    unsigned int target = static_cast<unsigned int>(sampleCount * fraction);
+    unsigned int seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen > target) {
+            return static_cast<std::int64_t>(i + 1) * BUCKET_US;  // Upper edge of the bucket
+        }
+    }
+    return maxUs;
+}
+
+void LatencyMeter::report(std::ostream& out, const std::string& label) const {
+    if (sampleCount == 0) {
+        out << "[latency] " << label << ": no samples" << std::endl;
+        return;
+    }
+
+    out << std::fixed << std::setprecision(2)
+        << "[latency] " << label << ": " << sampleCount << " samples"
+        << ", mean " << (totalUs / 1000.0) / sampleCount << " ms"
+        << ", p50 " << percentile(0.5f) / 1000.0 << " ms"
+        << ", p99 " << percentile(0.99f) / 1000.0 << " ms"
+        << ", max " << maxUs / 1000.0 << " ms" << std::endl;
+}
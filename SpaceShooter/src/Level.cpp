@@ -0,0 +1,397 @@
+#include "Level.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace LevelFormat;
+
+namespace {
+    // Pages requested ahead of the chunk being read (a few seconds of spawns
+    // even for dense levels); re-requested once half of it has been consumed
+    const std::size_t PREFETCH_BYTES = 64 * 1024;
+
+    // Formation members waiting for their delay
+    const std::size_t PENDING_RESERVE = 64;
+
+    std::size_t pageSize() {
+        static const std::size_t size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+}
+
+LevelStream::LevelStream()
+    : base(nullptr)
+    , fileSize(0)
+    , header()
+    , chunkOffset(0)
+    , chunk()
+    , chunkLoaded(false)
+    , nextRecord(0)
+    , lastTick(0)
+    , prefetchedTo(0)
+    , releasedTo(0)
+    , failed(false) {}
+
+LevelStream::~LevelStream() {
+    close();
+}
+
+void LevelStream::close() {
+    if (base) {
+        munmap(const_cast<std::uint8_t*>(base), fileSize);
+    }
+    base = nullptr;
+    fileSize = 0;
+    pathNames.clear();
+    formations.clear();
+    members.clear();
+    pending.clear();
+}
+
+bool LevelStream::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Failed to open level: " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(fd);
+        std::cerr << "Invalid level: " << path << std::endl;
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Failed to map level: " << path << std::endl;
+        return false;
+    }
+
+    base = static_cast<const std::uint8_t*>(mapping);
+    fileSize = size;
+
+    // Only the header and tables are checked here; chunks are checked as they're reached
+    std::memcpy(&header, base, sizeof(Header));
+    std::uint64_t tablesEnd = sizeof(Header) + std::uint64_t(header.pathCount) * sizeof(PathName)
+                            + std::uint64_t(header.formationCount) * sizeof(Formation)
+                            + std::uint64_t(header.memberCount) * sizeof(FormationMember);
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+              && header.version == VERSION
+              && header.chunkTicks > 0 && header.chunkTicks <= MAX_CHUNK_TICKS
+              && header.pathCount <= MAX_TABLE_SIZE
+              && header.formationCount <= MAX_TABLE_SIZE
+              && header.memberCount <= MAX_MEMBERS
+              && tablesEnd <= header.firstChunkOffset
+              && header.firstChunkOffset <= fileSize;
+
+    if (valid) {
+        const std::uint8_t* table = base + sizeof(Header);
+        for (std::uint32_t i = 0; i < header.pathCount && valid; ++i, table += sizeof(PathName)) {
+            PathName name;
+            std::memcpy(&name, table, sizeof(name));
+            valid = std::memchr(name.name, '\0', MAX_PATH_NAME) != nullptr;
+            pathNames.push_back(valid ? name.name : "");
+        }
+
+        formations.resize(header.formationCount);
+        std::memcpy(formations.data(), table, formations.size() * sizeof(Formation));
+        table += formations.size() * sizeof(Formation);
+        members.resize(header.memberCount);
+        std::memcpy(members.data(), table, members.size() * sizeof(FormationMember));
+
+        for (const Formation& f : formations) {
+            valid = valid && f.memberCount > 0 && f.firstMember <= header.memberCount
+                 && f.memberCount <= header.memberCount - f.firstMember;
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Invalid level: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    // Chunks are read front to back
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    pending.reserve(PENDING_RESERVE);
+    rewind();
+    return true;
+}
+
+bool LevelStream::isOpen() const {
+    return base != nullptr;
+}
+
+void LevelStream::rewind() {
+    chunkOffset = header.firstChunkOffset;
+    chunkLoaded = false;
+    nextRecord = 0;
+    lastTick = 0;
+    prefetchedTo = 0;
+    releasedTo = 0;
+    failed = false;
+    pending.clear();
+}
+
+void LevelStream::poll(std::uint64_t tick, std::vector<LevelSpawn>& out) {
+    if (!base) return;
+
+    // Expand every record up to tick; a record past it waits for a later poll
+    while (chunkLoaded || loadChunk()) {
+        if (nextRecord == chunk.recordCount) {
+            chunkOffset += sizeof(ChunkHeader) + std::uint64_t(chunk.recordCount) * sizeof(SpawnRecord);
+            chunkLoaded = false;
+            continue;
+        }
+
+        SpawnRecord record;
+        std::memcpy(&record, base + chunkOffset + sizeof(ChunkHeader) + std::size_t(nextRecord) * sizeof(SpawnRecord),
+                    sizeof(record));
+        std::uint64_t recordTick = chunk.startTick + record.tickOffset;
+        bool valid = record.tickOffset < header.chunkTicks
+                  && recordTick >= lastTick
+                  && record.path < header.pathCount
+                  && (record.formation == NO_FORMATION || record.formation < header.formationCount)
+                  && record.speedTenths > 0;
+        if (!valid) {
+            std::cerr << "Corrupt level record at offset " << chunkOffset << ", stopping the level" << std::endl;
+            failed = true;
+            chunkLoaded = false;
+            break;
+        }
+
+        if (recordTick > tick) break;
+        expand(record, recordTick);
+        lastTick = recordTick;
+        ++nextRecord;
+    }
+
+    // Due spawns leave in tick order
+    std::size_t due = 0;
+    while (due < pending.size() && pending[due].tick <= tick) {
+        ++due;
+    }
+    out.insert(out.end(), pending.begin(), pending.begin() + due);
+    pending.erase(pending.begin(), pending.begin() + due);
+}
+
+bool LevelStream::isFinished() const {
+    return base && (failed || (!chunkLoaded && chunkOffset >= fileSize)) && pending.empty();
+}
+
+const std::vector<std::string>& LevelStream::getPathNames() const {
+    return pathNames;
+}
+
+std::uint64_t LevelStream::getLength() const {
+    return header.lengthTicks;
+}
+
+std::uint32_t LevelStream::getRecordCount() const {
+    return header.recordCount;
+}
+
+bool LevelStream::loadChunk() {
+    if (failed || chunkOffset >= fileSize) {
+        return false;
+    }
+
+    bool valid = fileSize - chunkOffset >= sizeof(ChunkHeader);
+    if (valid) {
+        std::memcpy(&chunk, base + chunkOffset, sizeof(ChunkHeader));
+        valid = chunk.recordCount <= (fileSize - chunkOffset - sizeof(ChunkHeader)) / sizeof(SpawnRecord);
+    }
+    if (!valid) {
+        std::cerr << "Corrupt level chunk at offset " << chunkOffset << ", stopping the level" << std::endl;
+        failed = true;
+        return false;
+    }
+
+    chunkLoaded = true;
+    nextRecord = 0;
+    advanceWindow();
+    return true;
+}
+
+void LevelStream::advanceWindow() {
+    std::size_t page = pageSize();
+
+    // Pages wholly behind the current chunk won't be read again (until a rewind)
+    std::size_t behind = static_cast<std::size_t>(chunkOffset) / page * page;
+    if (behind > releasedTo) {
+        madvise(const_cast<std::uint8_t*>(base) + releasedTo, behind - releasedTo, MADV_DONTNEED);
+        releasedTo = behind;
+    }
+
+    // Keep the kernel reading ahead of the clock, so no chunk load waits on the disk
+    if (prefetchedTo < chunkOffset + PREFETCH_BYTES / 2 && prefetchedTo < fileSize) {
+        std::size_t from = std::max(prefetchedTo, static_cast<std::size_t>(chunkOffset)) / page * page;
+        std::size_t to = std::min(fileSize, static_cast<std::size_t>(chunkOffset) + PREFETCH_BYTES);
+        madvise(const_cast<std::uint8_t*>(base) + from, to - from, MADV_WILLNEED);
+        prefetchedTo = to;
+    }
+}
+
+void LevelStream::expand(const SpawnRecord& record, std::uint64_t tick) {
+    LevelSpawn spawn;
+    spawn.path = record.path;
+    spawn.pattern = record.pattern == NO_PATTERN ? -1 : record.pattern;
+    spawn.timeScale = record.speedTenths / 10.f;
+    spawn.fireDelay = record.fireDelayMs / 1000.f;
+
+    auto insert = [this](const LevelSpawn& s) {
+        auto byTick = [](const LevelSpawn& a, const LevelSpawn& b) { return a.tick < b.tick; };
+        pending.insert(std::upper_bound(pending.begin(), pending.end(), s, byTick), s);
+    };
+
+    if (record.formation == NO_FORMATION) {
+        spawn.tick = tick;
+        spawn.x = record.x;
+        spawn.dy = 0.f;
+        insert(spawn);
+        return;
+    }
+
+    const Formation& formation = formations[record.formation];
+    for (std::uint32_t i = 0; i < formation.memberCount; ++i) {
+        const FormationMember& member = members[formation.firstMember + i];
+        spawn.tick = tick + member.delayTicks;
+        spawn.x = static_cast<float>(record.x + member.dx);
+        spawn.dy = member.dy;
+        insert(spawn);
+    }
+}
+
+// LevelWriter implementation
+LevelWriter::LevelWriter(std::uint32_t ticks)
+    : chunkTicks(std::min(std::max(ticks, 1u), MAX_CHUNK_TICKS))
+    , file(nullptr)
+    , header()
+    , chunkStart(0)
+    , ok(false) {}
+
+LevelWriter::~LevelWriter() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+int LevelWriter::addPath(const std::string& name) {
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (name == paths[i].name) return static_cast<int>(i);
+    }
+    if (file || paths.size() >= MAX_TABLE_SIZE || name.empty() || name.size() >= MAX_PATH_NAME) {
+        return -1;
+    }
+
+    PathName entry;
+    std::memset(&entry, 0, sizeof(entry));
+    std::memcpy(entry.name, name.data(), name.size());
+    paths.push_back(entry);
+    return static_cast<int>(paths.size()) - 1;
+}
+
+int LevelWriter::addFormation(const std::vector<FormationMember>& formationMembers) {
+    if (file || formations.size() >= MAX_TABLE_SIZE || formationMembers.empty()
+        || members.size() + formationMembers.size() > MAX_MEMBERS) {
+        return -1;
+    }
+
+    Formation formation;
+    formation.firstMember = static_cast<std::uint32_t>(members.size());
+    formation.memberCount = static_cast<std::uint32_t>(formationMembers.size());
+    formations.push_back(formation);
+    members.insert(members.end(), formationMembers.begin(), formationMembers.end());
+    return static_cast<int>(formations.size()) - 1;
+}
+
+bool LevelWriter::begin(const std::string& path) {
+    if (file) return false;
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to write level: " << path << std::endl;
+        return false;
+    }
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.chunkTicks = chunkTicks;
+    header.pathCount = static_cast<std::uint32_t>(paths.size());
+    header.formationCount = static_cast<std::uint32_t>(formations.size());
+    header.memberCount = static_cast<std::uint32_t>(members.size());
+    header.firstChunkOffset = sizeof(Header) + paths.size() * sizeof(PathName)
+                            + formations.size() * sizeof(Formation) + members.size() * sizeof(FormationMember);
+
+    ok = std::fwrite(&header, sizeof(header), 1, file) == 1
+      && std::fwrite(paths.data(), sizeof(PathName), paths.size(), file) == paths.size()
+      && std::fwrite(formations.data(), sizeof(Formation), formations.size(), file) == formations.size()
+      && std::fwrite(members.data(), sizeof(FormationMember), members.size(), file) == members.size();
+    chunkRecords.clear();
+    return ok;
+}
+
+bool LevelWriter::add(std::uint64_t tick, SpawnRecord record) {
+    if (!file || !ok) return false;
+
+    if (header.recordCount > 0 && tick < header.lengthTicks) {
+        std::cerr << "Level spawns must be added in tick order" << std::endl;
+        return false;
+    }
+    if (record.path >= paths.size() || (record.formation != NO_FORMATION && record.formation >= formations.size())
+        || record.speedTenths == 0) {
+        std::cerr << "Level spawn references a missing path or formation" << std::endl;
+        return false;
+    }
+
+    // Chunks cover fixed windows; a spawn past the current one closes it
+    std::uint64_t start = tick - tick % chunkTicks;
+    if (!chunkRecords.empty() && start != chunkStart) {
+        flushChunk();
+    }
+    chunkStart = start;
+
+    record.tickOffset = static_cast<std::uint16_t>(tick - chunkStart);
+    record.reserved = 0;
+    chunkRecords.push_back(record);
+    ++header.recordCount;
+    header.lengthTicks = tick;
+    return ok;
+}
+
+bool LevelWriter::flushChunk() {
+    ChunkHeader chunk;
+    chunk.startTick = chunkStart;
+    chunk.recordCount = static_cast<std::uint32_t>(chunkRecords.size());
+    chunk.reserved = 0;
+
+    ok = ok && std::fwrite(&chunk, sizeof(chunk), 1, file) == 1
+            && std::fwrite(chunkRecords.data(), sizeof(SpawnRecord), chunkRecords.size(), file) == chunkRecords.size();
+    ++header.chunkCount;
+    chunkRecords.clear();
+    return ok;
+}
+
+bool LevelWriter::finish() {
+    if (!file) return false;
+
+    if (!chunkRecords.empty()) {
+        flushChunk();
+    }
+
+    // Counts are only known now
+    ok = ok && std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
@@ -0,0 +1,329 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    // How often the server thread checks for stop() while idle
+    const int POLL_INTERVAL_MS = 100;
+
+    // A slow or stuck client is dropped after this long
+    const int CLIENT_TIMEOUT_MS = 1000;
+    const std::size_t MAX_REQUEST_BYTES = 8192;
+
+    void appendNumber(std::string& out, std::uint64_t value) {
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value));
+        out.append(text, static_cast<std::size_t>(length));
+    }
+
+    void appendNumber(std::string& out, double value) {
+        if (std::isinf(value)) {
+            out += value > 0 ? "+Inf" : "-Inf";
+            return;
+        }
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%.9g", value);
+        out.append(text, static_cast<std::size_t>(length));
+    }
+
+    bool sendAll(int fd, const std::string& data) {
+        std::size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+}
+
+Metric::Metric(const char* metricName, const char* metricHelp) : name(metricName), help(metricHelp) {}
+
+void Metric::writeHeader(std::string& out, const char* type) const {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += ' ';
+    out += type;
+    out += '\n';
+}
+
+MetricCounter::MetricCounter(const char* name, const char* help) : Metric(name, help), value(0) {}
+
+void MetricCounter::write(std::string& out) const {
+    writeHeader(out, "counter");
+    out += name;
+    out += ' ';
+    appendNumber(out, get());
+    out += '\n';
+}
+
+MetricGauge::MetricGauge(const char* name, const char* help) : Metric(name, help), value(0.0) {}
+
+void MetricGauge::write(std::string& out) const {
+    writeHeader(out, "gauge");
+    out += name;
+    out += ' ';
+    appendNumber(out, get());
+    out += '\n';
+}
+
+MetricHistogram::MetricHistogram(const char* name, const char* help, const std::vector<double>& bucketBounds)
+    : Metric(name, help)
+    , bounds()
+    , boundCount(static_cast<int>(std::min<std::size_t>(bucketBounds.size(), MAX_BUCKETS)))
+    , sum(0.0) {
+    std::copy(bucketBounds.begin(), bucketBounds.begin() + boundCount, bounds);
+    for (auto& count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double amount) {
+    int bucket = 0;
+    while (bucket < boundCount && amount > bounds[bucket]) {
+        ++bucket;
+    }
+    counts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    // No fetch_add for atomic doubles before C++20; uncontended this succeeds first time
+    double current = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(current, current + amount, std::memory_order_relaxed)) {
+    }
+}
+
+void MetricHistogram::write(std::string& out) const {
+    writeHeader(out, "histogram");
+
+    // Buckets are cumulative in the exposition format; _count is the +Inf bucket
+    std::uint64_t total = 0;
+    for (int i = 0; i <= boundCount; ++i) {
+        total += counts[i].load(std::memory_order_relaxed);
+        out += name;
+        out += "_bucket{le=\"";
+        if (i < boundCount) {
+            appendNumber(out, bounds[i]);
+        } else {
+            out += "+Inf";
+        }
+        out += "\"} ";
+        appendNumber(out, total);
+        out += '\n';
+    }
+    out += name;
+    out += "_sum ";
+    appendNumber(out, sum.load(std::memory_order_relaxed));
+    out += '\n';
+    out += name;
+    out += "_count ";
+    appendNumber(out, total);
+    out += '\n';
+}
+
+MetricCounter& MetricsRegistry::counter(const char* name, const char* help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.push_back(std::make_unique<MetricCounter>(name, help));
+    return static_cast<MetricCounter&>(*metrics.back());
+}
+
+MetricGauge& MetricsRegistry::gauge(const char* name, const char* help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.push_back(std::make_unique<MetricGauge>(name, help));
+    return static_cast<MetricGauge&>(*metrics.back());
+}
+
+MetricHistogram& MetricsRegistry::histogram(const char* name, const char* help, const std::vector<double>& bounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    metrics.push_back(std::make_unique<MetricHistogram>(name, help, bounds));
+    return static_cast<MetricHistogram&>(*metrics.back());
+}
+
+void MetricsRegistry::write(std::string& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out.clear();
+    for (const auto& metric : metrics) {
+        metric->write(out);
+    }
+}
+
+MetricsServer::MetricsServer(const MetricsRegistry& source)
+    : registry(source)
+    , listenFd(-1)
+    , port(0)
+    , running(false)
+    , scrapes(0) {}
+
+MetricsServer::~MetricsServer() {
+    stop();
+}
+
+bool MetricsServer::start(const std::string& address) {
+    if (running) return true;
+
+    if (address.find('/') != std::string::npos) {
+        sockaddr_un local = {};
+        local.sun_family = AF_UNIX;
+        if (address.size() >= sizeof(local.sun_path)) {
+            std::cerr << "Metrics socket path too long: " << address << std::endl;
+            return false;
+        }
+        std::memcpy(local.sun_path, address.c_str(), address.size() + 1);
+
+        // A socket left behind by an earlier run is replaced; anything else is not touched
+        struct stat info;
+        if (::stat(address.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+            ::unlink(address.c_str());
+        }
+
+        listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            std::cerr << "Failed to bind metrics socket " << address << ": " << std::strerror(errno) << std::endl;
+            stop();
+            return false;
+        }
+        socketPath = address;
+    } else {
+        char* end = nullptr;
+        long requested = std::strtol(address.c_str(), &end, 10);
+        if (address.empty() || *end != '\0' || requested < 0 || requested > 65535) {
+            std::cerr << "Metrics address must be a port or a socket path: " << address << std::endl;
+            return false;
+        }
+
+        // Loopback only: the endpoint is for local scrapers, not the network
+        sockaddr_in local = {};
+        local.sin_family = AF_INET;
+        local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        local.sin_port = htons(static_cast<std::uint16_t>(requested));
+
+        listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int reuse = 1;
+        if (listenFd >= 0) {
+            ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        }
+        if (listenFd < 0 || ::bind(listenFd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            std::cerr << "Failed to bind metrics port " << address << ": " << std::strerror(errno) << std::endl;
+            stop();
+            return false;
+        }
+
+        socklen_t length = sizeof(local);
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&local), &length);
+        port = ntohs(local.sin_port);
+    }
+
+    if (::listen(listenFd, 8) != 0) {
+        std::cerr << "Failed to listen for metrics scrapes: " << std::strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+
+    running = true;
+    thread = std::thread(&MetricsServer::serverLoop, this);
+    return true;
+}
+
+void MetricsServer::stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    if (listenFd >= 0) {
+        ::close(listenFd);
+        listenFd = -1;
+    }
+    if (!socketPath.empty()) {
+        ::unlink(socketPath.c_str());
+        socketPath.clear();
+    }
+}
+
+bool MetricsServer::isRunning() const {
+    return running;
+}
+
+std::string MetricsServer::getUrl() const {
+    if (!socketPath.empty()) {
+        return "unix:" + socketPath + ":/metrics";
+    }
+    return "http://127.0.0.1:" + std::to_string(port) + "/metrics";
+}
+
+int MetricsServer::getPort() const {
+    return port;
+}
+
+std::uint64_t MetricsServer::getScrapes() const {
+    return scrapes.load(std::memory_order_relaxed);
+}
+
+void MetricsServer::serverLoop() {
+    while (running) {
+        pollfd waiting = { listenFd, POLLIN, 0 };
+        if (::poll(&waiting, 1, POLL_INTERVAL_MS) <= 0) continue;
+
+        int client = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) continue;
+        serve(client);
+        ::close(client);
+    }
+}
+
+void MetricsServer::serve(int fd) {
+    // Read the request head; the body (if any) is ignored
+    request.clear();
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.find("\n\n") == std::string::npos) {
+        pollfd readable = { fd, POLLIN, 0 };
+        if (request.size() >= MAX_REQUEST_BYTES || ::poll(&readable, 1, CLIENT_TIMEOUT_MS) <= 0) return;
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+        request.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    // Request line: METHOD SP PATH SP VERSION; a query string doesn't matter
+    std::size_t methodEnd = request.find(' ');
+    std::size_t pathEnd = methodEnd == std::string::npos ? methodEnd : request.find_first_of(" ?\r\n", methodEnd + 1);
+    bool found = false;
+    if (pathEnd != std::string::npos) {
+        std::string method = request.substr(0, methodEnd);
+        std::string path = request.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+        found = (method == "GET" || method == "HEAD") && (path == "/metrics" || path == "/");
+    }
+
+    if (found) {
+        registry.write(body);
+        scrapes.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        body = "Not found; metrics are at /metrics\n";
+    }
+    bool head = request.compare(0, 5, "HEAD ") == 0;
+
+    response.clear();
+    response += found ? "HTTP/1.0 200 OK\r\n" : "HTTP/1.0 404 Not Found\r\n";
+    response += found ? "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n" : "Content-Type: text/plain\r\n";
+    response += "Content-Length: ";
+    response += std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    if (!head) {
+        response += body;
+    }
+    sendAll(fd, response);
+}
@@ -0,0 +1,443 @@
+#include "MovementSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // Used when no path file is available (same content as assets/paths.txt)
+    const char* const BUILTIN_PATHS[] = {
+        "straight linear speed=100",
+        "weave sine speed=80 amplitude=60 frequency=0.6",
+        "dive dive speed=50 delay=1.5 diveSpeed=320",
+        "swoop spline duration=6 points=0,0;90,150;-90,300;60,450;0,700"
+    };
+
+    // sin(2*pi*turns) without a libm call so the weave loop vectorizes.
+    // Parabolic approximation with one refinement step (max error ~0.001).
+    inline float fastSinTurns(float turns) {
+        float phase = turns - std::floor(turns + 0.5f);        // [-0.5, 0.5)
+        float y = 8.f * phase - 16.f * phase * std::fabs(phase);
+        return 0.225f * (y * std::fabs(y) - y) + y;
+    }
+
+    sf::Vector2f catmullRom(const sf::Vector2f& p0, const sf::Vector2f& p1,
+                            const sf::Vector2f& p2, const sf::Vector2f& p3, float u) {
+        float u2 = u * u;
+        float u3 = u2 * u;
+        return 0.5f * ((2.f * p1) + (p2 - p0) * u
+                       + (2.f * p0 - 5.f * p1 + 4.f * p2 - p3) * u2
+                       + (3.f * p1 - p0 - 3.f * p2 + p3) * u3);
+    }
+
+    Fixed catmullRomFixed(Fixed p0, Fixed p1, Fixed p2, Fixed p3, Fixed u) {
+        Fixed u2 = u * u;
+        Fixed u3 = u2 * u;
+        return (p1 * 2 + (p2 - p0) * u
+                + (p0 * 2 - p1 * 5 + p2 * 4 - p3) * u2
+                + (p1 * 3 - p0 - p2 * 3 + p3) * u3) / 2;
+    }
+}
+
+MovementSystem::MovementSystem() {
+    for (const char* line : BUILTIN_PATHS) {
+        PathDefinition path;
+        parsePath(line, path);
+        addPath(path);
+    }
+}
+
+bool MovementSystem::loadPaths(const std::string& filename) {
+    std::vector<PathDefinition> loaded;
+    if (!readPathFile(filename, loaded)) {
+        return false;
+    }
+    
+    setPaths(loaded);
+    return true;
+}
+
+void MovementSystem::setPaths(const std::vector<PathDefinition>& paths) {
+    clear();
+    batches.clear();
+    for (const auto& path : paths) {
+        addPath(path);
+    }
+}
+
+bool MovementSystem::readPathFile(const std::string& filename, std::vector<PathDefinition>& loaded) {
+    std::ifstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    std::ostringstream text;
+    text << file.rdbuf();
+    return readPathText(text.str(), filename, loaded);
+}
+
+bool MovementSystem::readPathText(const std::string& text, const std::string& source, std::vector<PathDefinition>& loaded) {
+    std::istringstream in(text);
+
+    // Format: one path per line, "name type key=value ...", '#' starts a comment
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        PathDefinition path;
+        if (!parsePath(line, path)) {
+            std::cerr << "Invalid path in " << source << " line " << lineNumber << std::endl;
+            return false;
+        }
+        loaded.push_back(path);
+    }
+
+    return !loaded.empty();
+}
+
+bool MovementSystem::parsePath(const std::string& line, PathDefinition& path) {
+    std::istringstream in(line);
+    std::string type;
+    if (!(in >> path.name >> type)) return false;
+
+    if (type == "linear") path.type = PathType::LINEAR;
+    else if (type == "sine") path.type = PathType::SINE_WEAVE;
+    else if (type == "dive") path.type = PathType::DIVE;
+    else if (type == "spline") path.type = PathType::SPLINE;
+    else return false;
+
+    std::string token;
+    while (in >> token) {
+        std::string::size_type eq = token.find('=');
+        if (eq == std::string::npos) return false;
+        std::string key = token.substr(0, eq);
+        std::string value = token.substr(eq + 1);
+
+        if (key == "points") {
+            // x,y;x,y;...
+            std::istringstream pointStream(value);
+            std::string point;
+            while (std::getline(pointStream, point, ';')) {
+                float x, y;
+                char comma;
+                std::istringstream p(point);
+                if (!(p >> x >> comma >> y) || comma != ',') return false;
+                path.points.push_back(sf::Vector2f(x, y));
+            }
+            continue;
+        }
+
+        float number;
+        std::istringstream v(value);
+        if (!(v >> number)) return false;
+
+        if (key == "speed") path.speed = number;
+        else if (key == "amplitude") path.amplitude = number;
+        else if (key == "frequency") path.frequency = number;
+        else if (key == "delay") path.diveDelay = number;
+        else if (key == "diveSpeed") path.diveSpeed = number;
+        else if (key == "duration") path.duration = number;
+        else return false;
+    }
+
+    if (path.type == PathType::SPLINE && (path.points.size() < 2 || path.duration <= 0.f)) return false;
+    return true;
+}
+
+void MovementSystem::addPath(const PathDefinition& path) {
+    PathBatch batch;
+    batch.definition = path;
+
+    FixedPath& fixed = batch.fixedPath;
+    fixed.speed = Fixed::fromFloat(path.speed);
+    fixed.amplitude = Fixed::fromFloat(path.amplitude);
+    fixed.frequency = Fixed::fromFloat(path.frequency);
+    fixed.diveDelay = Fixed::fromFloat(path.diveDelay);
+    fixed.diveSpeed = Fixed::fromFloat(path.diveSpeed);
+    fixed.duration = Fixed::fromFloat(path.duration);
+    if (path.points.size() >= 2) {
+        fixed.segmentsPerSecond = Fixed::fromInt(static_cast<int>(path.points.size()) - 1) / fixed.duration;
+    }
+    for (const sf::Vector2f& point : path.points) {
+        fixed.points.push_back(FixedVec2(Fixed::fromFloat(point.x), Fixed::fromFloat(point.y)));
+    }
+    batches.push_back(batch);
+}
+
+std::size_t MovementSystem::getPathCount() const {
+    return batches.size();
+}
+
+int MovementSystem::findPath(const std::string& name) const {
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+        if (batches[i].definition.name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+const PathDefinition& MovementSystem::getPath(std::size_t index) const {
+    return batches[index].definition;
+}
+
+MoverHandle MovementSystem::add(std::size_t path, float x, float y, float timeScale) {
+    PathBatch& batch = batches[path];
+
+    MoverHandle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<MoverHandle>(slots.size());
+        slots.push_back(Slot());
+    }
+    slots[handle] = Slot{static_cast<std::uint32_t>(path), static_cast<std::uint32_t>(batch.owner.size())};
+
+    batch.elapsed.push_back(0.f);
+    batch.timeScale.push_back(timeScale);
+    batch.originX.push_back(x);
+    batch.originY.push_back(y);
+    batch.outX.push_back(x);
+    batch.outY.push_back(y);
+    batch.fixedMovers.push_back(FixedMover());
+    batch.owner.push_back(handle);
+    return handle;
+}
+
+void MovementSystem::remove(MoverHandle handle) {
+    if (handle >= slots.size()) return;
+
+    Slot slot = slots[handle];
+    PathBatch& batch = batches[slot.path];
+    std::size_t last = batch.owner.size() - 1;
+
+    // Swap-remove keeps each batch dense
+    if (slot.index != last) {
+        batch.elapsed[slot.index] = batch.elapsed[last];
+        batch.timeScale[slot.index] = batch.timeScale[last];
+        batch.originX[slot.index] = batch.originX[last];
+        batch.originY[slot.index] = batch.originY[last];
+        batch.outX[slot.index] = batch.outX[last];
+        batch.outY[slot.index] = batch.outY[last];
+        batch.fixedMovers[slot.index] = batch.fixedMovers[last];
+        batch.owner[slot.index] = batch.owner[last];
+        slots[batch.owner[slot.index]].index = slot.index;
+    }
+
+    batch.elapsed.pop_back();
+    batch.timeScale.pop_back();
+    batch.originX.pop_back();
+    batch.originY.pop_back();
+    batch.outX.pop_back();
+    batch.outY.pop_back();
+    batch.fixedMovers.pop_back();
+    batch.owner.pop_back();
+
+    freeHandles.push_back(handle);
+}
+
+void MovementSystem::reserve(std::size_t moversPerPath) {
+    for (auto& batch : batches) {
+        batch.elapsed.reserve(moversPerPath);
+        batch.timeScale.reserve(moversPerPath);
+        batch.originX.reserve(moversPerPath);
+        batch.originY.reserve(moversPerPath);
+        batch.outX.reserve(moversPerPath);
+        batch.outY.reserve(moversPerPath);
+        batch.fixedMovers.reserve(moversPerPath);
+        batch.owner.reserve(moversPerPath);
+    }
+    slots.reserve(moversPerPath * batches.size());
+    freeHandles.reserve(moversPerPath * batches.size());
+}
+
+void MovementSystem::clear() {
+    for (auto& batch : batches) {
+        batch.elapsed.clear();
+        batch.timeScale.clear();
+        batch.originX.clear();
+        batch.originY.clear();
+        batch.outX.clear();
+        batch.outY.clear();
+        batch.fixedMovers.clear();
+        batch.owner.clear();
+    }
+    slots.clear();
+    freeHandles.clear();
+}
+
+void MovementSystem::update(float dt) {
+    for (auto& batch : batches) {
+        // Advance local time (vectorizable)
+        float* elapsed = batch.elapsed.data();
+        const float* timeScale = batch.timeScale.data();
+        std::size_t n = batch.elapsed.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            elapsed[i] += dt * timeScale[i];
+        }
+
+        evaluate(batch);
+    }
+}
+
+void MovementSystem::evaluate(PathBatch& batch) {
+    const PathDefinition& path = batch.definition;
+    const float* t = batch.elapsed.data();
+    const float* ox = batch.originX.data();
+    const float* oy = batch.originY.data();
+    float* x = batch.outX.data();
+    float* y = batch.outY.data();
+    std::size_t n = batch.elapsed.size();
+
+    // One loop per path type; the switch is hoisted out of the per-mover work
+    switch (path.type) {
+        case PathType::LINEAR: {
+            const float speed = path.speed;
+            for (std::size_t i = 0; i < n; ++i) {
+                x[i] = ox[i];
+                y[i] = oy[i] + speed * t[i];
+            }
+            break;
+        }
+
+        case PathType::SINE_WEAVE: {
+            const float speed = path.speed;
+            const float amplitude = path.amplitude;
+            const float frequency = path.frequency;
+            for (std::size_t i = 0; i < n; ++i) {
+                x[i] = ox[i] + amplitude * fastSinTurns(frequency * t[i]);
+                y[i] = oy[i] + speed * t[i];
+            }
+            break;
+        }
+
+        case PathType::DIVE: {
+            const float speed = path.speed;
+            const float delay = path.diveDelay;
+            const float diveSpeed = path.diveSpeed;
+            for (std::size_t i = 0; i < n; ++i) {
+                float cruise = std::min(t[i], delay);
+                float dive = std::max(t[i] - delay, 0.f);
+                x[i] = ox[i];
+                y[i] = oy[i] + speed * cruise + diveSpeed * dive;
+            }
+            break;
+        }
+
+        case PathType::SPLINE: {
+            const std::vector<sf::Vector2f>& p = path.points;
+            const int segments = static_cast<int>(p.size()) - 1;
+            const float segmentsPerSecond = segments / path.duration;
+            const sf::Vector2f exitVelocity = (p[segments] - p[segments - 1]) * segmentsPerSecond;
+
+            for (std::size_t i = 0; i < n; ++i) {
+                float s = t[i] * segmentsPerSecond;
+                sf::Vector2f offset;
+                if (s >= segments) {
+                    // Past the last point: keep going in the final direction
+                    offset = p[segments] + exitVelocity * (t[i] - path.duration);
+                } else {
+                    int seg = static_cast<int>(s);
+                    offset = catmullRom(p[std::max(seg - 1, 0)], p[seg], p[seg + 1],
+                                        p[std::min(seg + 2, segments)], s - seg);
+                }
+                x[i] = ox[i] + offset.x;
+                y[i] = oy[i] + offset.y;
+            }
+            break;
+        }
+    }
+}
+
+MoverHandle MovementSystem::addFixed(std::size_t path, const FixedVec2& pos, Fixed timeScale) {
+    MoverHandle handle = add(path, pos.x.toFloat(), pos.y.toFloat(), timeScale.toFloat());
+    const Slot& slot = slots[handle];
+    batches[path].fixedMovers[slot.index] = FixedMover{Fixed(), timeScale, pos, pos};
+    return handle;
+}
+
+void MovementSystem::updateFixed(int ticksPerSecond) {
+    for (auto& batch : batches) {
+        for (FixedMover& mover : batch.fixedMovers) {
+            mover.elapsedTicks += mover.timeScale;
+        }
+
+        evaluateFixed(batch, ticksPerSecond);
+
+        for (std::size_t i = 0; i < batch.fixedMovers.size(); ++i) {
+            batch.outX[i] = batch.fixedMovers[i].out.x.toFloat();
+            batch.outY[i] = batch.fixedMovers[i].out.y.toFloat();
+        }
+    }
+}
+
+void MovementSystem::evaluateFixed(PathBatch& batch, int ticksPerSecond) {
+    // Same curves as evaluate(), on integers
+    const FixedPath& path = batch.fixedPath;
+    for (FixedMover& mover : batch.fixedMovers) {
+        Fixed t = mover.elapsedTicks / ticksPerSecond;
+        FixedVec2 offset;
+
+        switch (batch.definition.type) {
+            case PathType::LINEAR:
+                offset.y = path.speed * t;
+                break;
+
+            case PathType::SINE_WEAVE:
+                offset.x = path.amplitude * Fixed::sinTurns(path.frequency * t);
+                offset.y = path.speed * t;
+                break;
+
+            case PathType::DIVE: {
+                Fixed cruise = Fixed::min(t, path.diveDelay);
+                Fixed dive = Fixed::max(t - path.diveDelay, Fixed());
+                offset.y = path.speed * cruise + path.diveSpeed * dive;
+                break;
+            }
+
+            case PathType::SPLINE: {
+                const std::vector<FixedVec2>& p = path.points;
+                const int segments = static_cast<int>(p.size()) - 1;
+                Fixed s = t * path.segmentsPerSecond;
+                if (s >= Fixed::fromInt(segments)) {
+                    Fixed past = t - path.duration;
+                    offset.x = p[segments].x + (p[segments].x - p[segments - 1].x) * path.segmentsPerSecond * past;
+                    offset.y = p[segments].y + (p[segments].y - p[segments - 1].y) * path.segmentsPerSecond * past;
+                } else {
+                    int seg = s.floor();
+                    Fixed u = s - Fixed::fromInt(seg);
+                    const FixedVec2& p0 = p[std::max(seg - 1, 0)];
+                    const FixedVec2& p1 = p[seg];
+                    const FixedVec2& p2 = p[seg + 1];
+                    const FixedVec2& p3 = p[std::min(seg + 2, segments)];
+                    offset.x = catmullRomFixed(p0.x, p1.x, p2.x, p3.x, u);
+                    offset.y = catmullRomFixed(p0.y, p1.y, p2.y, p3.y, u);
+                }
+                break;
+            }
+        }
+
+        mover.out = FixedVec2(mover.origin.x + offset.x, mover.origin.y + offset.y);
+    }
+}
+
+const FixedVec2& MovementSystem::getFixedPosition(MoverHandle handle) const {
+    const Slot& slot = slots[handle];
+    return batches[slot.path].fixedMovers[slot.index].out;
+}
+
+sf::Vector2f MovementSystem::getPosition(MoverHandle handle) const {
+    const Slot& slot = slots[handle];
+    const PathBatch& batch = batches[slot.path];
+    return sf::Vector2f(batch.outX[slot.index], batch.outY[slot.index]);
+}
+
+std::size_t MovementSystem::size() const {
+    return slots.size() - freeHandles.size();
+}
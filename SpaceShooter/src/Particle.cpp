@@ -1,5 +1,6 @@
 #include "Particle.h"
 #include "ResourceManager.h"
+#include <algorithm>
 #include <cmath>
 #include <random>
 
@@ -28,11 +29,8 @@ Particle::Particle(float x, float y, const sf::Texture& texture)
 void Particle::update(float dt) {
     if (!active) return;
     
-    lifetime += dt;
-    if (lifetime >= maxLifetime) {
-        active = false;
-        return;
-    }
+    // Age only drives the fade; the end of life is a timer
+    lifetime = std::min(lifetime + dt, maxLifetime);
     
     // Move particle
     sprite.move(velocity * dt);
@@ -44,44 +42,93 @@ void Particle::update(float dt) {
     sprite.setColor(color);
 }
 
-void Particle::render(sf::RenderWindow& window) {
+void Particle::render(RenderBackend& backend) {
     if (active) {
-        window.draw(sprite);
+        backend.drawSprite(sprite);
     }
 }
 
+void Particle::expire() {
+    active = false;
+}
+
 bool Particle::isActive() const {
     return active;
 }
 
+float Particle::getMaxLifetime() const {
+    return maxLifetime;
+}
+
 // ParticleSystem implementation
+ParticleSystem::ParticleSystem() {
+    particles.reserve(RESERVE);
+    expiry.reserve(RESERVE);
+    freeSlots.reserve(RESERVE);
+}
+
+void ParticleSystem::attach(TimingWheel& wheel, float tick) {
+    timers = &wheel;
+    tickLength = tick;
+}
+
 void ParticleSystem::createExplosion(float x, float y, int particleCount) {
-    const sf::Texture& texture = ResourceManager::getInstance().getTexture("particle");
+    if (!texture) {
+        texture = &ResourceManager::getInstance().getTexture("particle");
+    }
     
-    for (int i = 0; i < particleCount; ++i) {
-        particles.emplace_back(x, y, texture);
+    // Always keep at least one particle so hits stay visible
+    int count = std::max(1, static_cast<int>(particleCount * emissionScale));
+    for (int i = 0; i < count; ++i) {
+        std::uint32_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            particles[slot] = Particle(x, y, *texture);
+        } else {
+            slot = static_cast<std::uint32_t>(particles.size());
+            particles.emplace_back(x, y, *texture);
+            expiry.push_back(TimingWheel::INVALID_TIMER);
+        }
+        
+        std::uint64_t ticks = TimingWheel::toTicks(particles[slot].getMaxLifetime(), tickLength);
+        expiry[slot] = timers->schedule(ticks, [this, slot]() { retire(slot); });
     }
 }
 
+void ParticleSystem::retire(std::uint32_t slot) {
+    particles[slot].expire();
+    expiry[slot] = TimingWheel::INVALID_TIMER;
+    freeSlots.push_back(slot);
+}
+
 void ParticleSystem::update(float dt) {
     for (auto& particle : particles) {
         particle.update(dt);
     }
-    
-    // Remove dead particles
-    particles.erase(
-        std::remove_if(particles.begin(), particles.end(),
-            [](const Particle& p) { return !p.isActive(); }),
-        particles.end()
-    );
 }
 
-void ParticleSystem::render(sf::RenderWindow& window) {
+void ParticleSystem::render(RenderBackend& backend) {
     for (auto& particle : particles) {
-        particle.render(window);
+        particle.render(backend);
     }
 }
 
 void ParticleSystem::clear() {
+    if (timers) {
+        for (TimingWheel::TimerId id : expiry) {
+            timers->cancel(id);
+        }
+    }
     particles.clear();
+    expiry.clear();
+    freeSlots.clear();
+}
+
+void ParticleSystem::setEmissionScale(float scale) {
+    emissionScale = scale;
+}
+
+std::size_t ParticleSystem::getLiveCount() const {
+    return particles.size() - freeSlots.size();
 }
@@ -1,54 +1,74 @@
 #include "Player.h"
-#include "ResourceManager.h"
-#include <SFML/Window/Keyboard.hpp>
+#include "Playfield.h"
+#include <cmath>
 
-Player::Player() : health(100), maxHealth(100), shootCooldown(0.2f), shootTimer(0.f) {
+namespace {
+    // Per-axis speed factor of diagonal movement, 1/sqrt(2)
+    const Fixed DIAGONAL = Fixed::sqrt(Fixed::fromRaw(Fixed::ONE / 2));
+}
+
+Player::Player(const sf::Texture* texture) : health(100), maxHealth(100), shootCooldown(0.2f), weaponReady(true) {
     speed = 300.f;
-    setTexture(ResourceManager::getInstance().getTexture("player"));
-    
-    // Center the origin
-    sf::FloatRect bounds = sprite.getLocalBounds();
-    sprite.setOrigin(bounds.width / 2.f, bounds.height / 2.f);
+    initSprite(texture, 32.f, 32.f);
 }
 
 void Player::update(float dt) {
-    handleInput(dt);
-    
-    // Update shoot timer
-    if (shootTimer > 0.f) {
-        shootTimer -= dt;
-    }
+    handleInput();
     
     // Apply velocity (with delta time for frame-independent movement)
     sprite.move(velocity * dt);
     
-    // Keep player within screen bounds
+    // Keep player within the play field
+    const float margin = Playfield::PLAYER_MARGIN;
     sf::Vector2f pos = sprite.getPosition();
-    if (pos.x < 20.f) pos.x = 20.f;
-    if (pos.x > 780.f) pos.x = 780.f;
-    if (pos.y < 20.f) pos.y = 20.f;
-    if (pos.y > 580.f) pos.y = 580.f;
+    if (pos.x < margin) pos.x = margin;
+    if (pos.x > Playfield::WIDTH - margin) pos.x = Playfield::WIDTH - margin;
+    if (pos.y < margin) pos.y = margin;
+    if (pos.y > Playfield::HEIGHT - margin) pos.y = Playfield::HEIGHT - margin;
     sprite.setPosition(pos);
 }
 
-void Player::handleInput(float dt) {
+void Player::updateFixed(int ticksPerSecond) {
+    // Same rules as update() and handleInput(); velocities are per tick
+    Fixed step = Fixed::fromFloat(speed) / ticksPerSecond;
+    int dx = input.right ? 1 : input.left ? -1 : 0;     // Right and down win, as in handleInput()
+    int dy = input.down ? 1 : input.up ? -1 : 0;
+    if (dx != 0 && dy != 0) {
+        step = step * DIAGONAL;
+    }
+    fixedVelocity = FixedVec2(step * dx, step * dy);
+    
+    const Fixed margin = Fixed::fromFloat(Playfield::PLAYER_MARGIN);
+    const Fixed right = Fixed::fromFloat(Playfield::WIDTH) - margin;
+    const Fixed bottom = Fixed::fromFloat(Playfield::HEIGHT) - margin;
+    FixedVec2 pos(fixedPosition.x + fixedVelocity.x, fixedPosition.y + fixedVelocity.y);
+    pos.x = Fixed::min(Fixed::max(pos.x, margin), right);
+    pos.y = Fixed::min(Fixed::max(pos.y, margin), bottom);
+    setFixedPosition(pos);
+}
+
+void Player::setInput(const PlayerInput& newInput) {
+    input = newInput;
+}
+
+const PlayerInput& Player::getInput() const {
+    return input;
+}
+
+void Player::handleInput() {
     velocity = sf::Vector2f(0.f, 0.f);
     
-    // Movement with WASD or Arrow keys
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
+    // Movement from the sampled actions (WASD or Arrow keys)
+    if (input.up) {
         velocity.y = -speed;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
+    if (input.down) {
         velocity.y = speed;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
+    if (input.left) {
         velocity.x = -speed;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D) || 
-        sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
+    if (input.right) {
         velocity.x = speed;
     }
     
@@ -60,12 +80,20 @@ void Player::handleInput(float dt) {
     }
 }
 
-bool Player::canShoot() {
-    return shootTimer <= 0.f;
+bool Player::canShoot() const {
+    return weaponReady;
+}
+
+void Player::disarm() {
+    weaponReady = false;
+}
+
+void Player::rearm() {
+    weaponReady = true;
 }
 
-void Player::resetShootTimer() {
-    shootTimer = shootCooldown;
+float Player::getShootCooldown() const {
+    return shootCooldown;
 }
 
 void Player::takeDamage(int damage) {
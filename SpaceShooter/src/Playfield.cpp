@@ -0,0 +1,32 @@
+#include "Playfield.h"
+#include <algorithm>
+
+namespace {
+    // Viewport (in window fractions) of the largest field-shaped area that fits
+    sf::FloatRect fitViewport(const sf::Vector2u& windowSize) {
+        float windowAspect = static_cast<float>(windowSize.x) / std::max(1u, windowSize.y);
+        float fieldAspect = Playfield::WIDTH / Playfield::HEIGHT;
+        if (windowAspect > fieldAspect) {
+            float width = fieldAspect / windowAspect;
+            return sf::FloatRect((1.f - width) / 2.f, 0.f, width, 1.f);
+        }
+        float height = windowAspect / fieldAspect;
+        return sf::FloatRect(0.f, (1.f - height) / 2.f, 1.f, height);
+    }
+}
+
+sf::FloatRect Playfield::bounds() {
+    return sf::FloatRect(0.f, 0.f, WIDTH, HEIGHT);
+}
+
+sf::View Playfield::letterboxView(const sf::Vector2u& windowSize) {
+    sf::View view(bounds());
+    view.setViewport(fitViewport(windowSize));
+    return view;
+}
+
+sf::Vector2u Playfield::viewportPixels(const sf::Vector2u& windowSize) {
+    sf::FloatRect viewport = fitViewport(windowSize);
+    return sf::Vector2u(std::max(1u, static_cast<unsigned int>(viewport.width * windowSize.x + 0.5f)),
+                        std::max(1u, static_cast<unsigned int>(viewport.height * windowSize.y + 0.5f)));
+}
@@ -0,0 +1,193 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+namespace {
+    // Static storage is zero-initialized before any allocation can happen, so the
+    // hooks below are safe even during static initialization
+    struct ZoneCounters {
+        const char* name;
+        std::atomic<std::uint64_t> allocations;
+        std::atomic<std::uint64_t> bytes;
+        std::atomic<std::uint64_t> timeNs;
+    };
+
+    ZoneCounters zones[Profiler::MAX_ZONES + 1];     // [0] collects allocations outside any zone
+    std::atomic<int> zoneCount(1);
+    std::mutex registerMutex;
+
+    std::atomic<bool> tracking(false);
+    std::atomic<std::uint64_t> frees(0);
+    thread_local int currentZone = 0;
+
+    // Totals at the previous endFrame
+    std::uint64_t lastAllocations[Profiler::MAX_ZONES + 1];
+    std::uint64_t lastBytes[Profiler::MAX_ZONES + 1];
+    std::uint64_t lastTimeNs[Profiler::MAX_ZONES + 1];
+    std::uint64_t lastFrees = 0;
+    Profiler::Frame lastFrame;
+
+    std::int64_t nowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    inline void recordAllocation(std::size_t size) {
+        if (!tracking.load(std::memory_order_relaxed)) return;
+        ZoneCounters& zone = zones[currentZone];
+        zone.allocations.fetch_add(1, std::memory_order_relaxed);
+        zone.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    inline void recordFree() {
+        if (!tracking.load(std::memory_order_relaxed)) return;
+        frees.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::setAllocationTracking(bool enabled) {
+    tracking.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isAllocationTracking() {
+    return tracking.load(std::memory_order_relaxed);
+}
+
+int Profiler::zone(const char* name) {
+    // Call sites pass string literals, so a pointer match is the common case
+    int count = zoneCount.load(std::memory_order_acquire);
+    for (int i = 1; i < count; ++i) {
+        if (zones[i].name == name) return i;
+    }
+
+    std::lock_guard<std::mutex> lock(registerMutex);
+    count = zoneCount.load(std::memory_order_relaxed);
+    for (int i = 1; i < count; ++i) {
+        if (std::strcmp(zones[i].name, name) == 0) return i;
+    }
+    if (count > MAX_ZONES) {
+        return 0;
+    }
+    zones[count].name = name;
+    zoneCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+const Profiler::Frame& Profiler::endFrame() {
+    Frame& frame = lastFrame;
+    frame.allocations = 0;
+    frame.bytes = 0;
+    frame.zoneCount = zoneCount.load(std::memory_order_acquire);
+
+    for (int i = 0; i < frame.zoneCount; ++i) {
+        std::uint64_t allocations = zones[i].allocations.load(std::memory_order_relaxed);
+        std::uint64_t bytes = zones[i].bytes.load(std::memory_order_relaxed);
+        std::uint64_t timeNs = zones[i].timeNs.load(std::memory_order_relaxed);
+
+        ZoneFrame& z = frame.zones[i];
+        z.name = i == 0 ? "(no zone)" : zones[i].name;
+        z.allocations = allocations - lastAllocations[i];
+        z.bytes = bytes - lastBytes[i];
+        z.timeMs = (timeNs - lastTimeNs[i]) / 1.0e6;
+        frame.allocations += z.allocations;
+        frame.bytes += z.bytes;
+
+        lastAllocations[i] = allocations;
+        lastBytes[i] = bytes;
+        lastTimeNs[i] = timeNs;
+    }
+
+    std::uint64_t totalFrees = frees.load(std::memory_order_relaxed);
+    frame.frees = totalFrees - lastFrees;
+    lastFrees = totalFrees;
+    return frame;
+}
+
+const Profiler::Frame& Profiler::getLastFrame() {
+    return lastFrame;
+}
+
+void Profiler::report(std::ostream& out, const Frame& frame) {
+    const ZoneFrame* order[MAX_ZONES + 1];
+    int count = 0;
+    for (int i = 0; i < frame.zoneCount; ++i) {
+        if (frame.zones[i].allocations > 0) order[count++] = &frame.zones[i];
+    }
+    std::sort(order, order + count, [](const ZoneFrame* a, const ZoneFrame* b) {
+        return a->allocations > b->allocations;
+    });
+
+    out << "  " << frame.allocations << " allocations, " << frame.bytes << " bytes, "
+        << frame.frees << " frees" << std::endl;
+    for (int i = 0; i < count; ++i) {
+        out << "    " << std::left << std::setw(14) << order[i]->name << std::right
+            << std::setw(6) << order[i]->allocations << " allocs "
+            << std::setw(8) << order[i]->bytes << " bytes" << std::endl;
+    }
+}
+
+ProfileZone::ProfileZone(const char* name)
+    : index(Profiler::zone(name))
+    , previous(currentZone)
+    , startNs(nowNs()) {
+    currentZone = index;
+}
+
+ProfileZone::~ProfileZone() {
+    zones[index].timeNs.fetch_add(static_cast<std::uint64_t>(nowNs() - startNs), std::memory_order_relaxed);
+    currentZone = previous;
+}
+
+// Global allocation hooks. Everything still goes through malloc/free; the hooks
+// only count, and only while tracking is enabled.
+void* operator new(std::size_t size) {
+    recordAllocation(size);
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    recordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    recordFree();
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    operator delete(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    operator delete(p);
+}
@@ -0,0 +1,350 @@
+#include "Projectile.h"
+#include "Playfield.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Projectiles are culled once they leave the field by this margin
+    const float CULL_MARGIN = Playfield::CULL_MARGIN;
+    const float FIELD_WIDTH = Playfield::WIDTH;
+    const float FIELD_HEIGHT = Playfield::HEIGHT;
+    const float GRID_CELL = 32.f;
+    const float REMOVED = 1.0e9f;   // Hit projectiles are parked here until the next cull
+    const Fixed FIXED_REMOVED = Fixed::fromInt(30000);
+    const float DEG_TO_RAD = 3.14159265f / 180.f;
+    const sf::Color PROJECTILE_COLOR(255, 120, 200);
+
+    // Grid and vertex storage allocated up front (grows past this on demand)
+    const std::size_t WORKING_SET = 2048;
+}
+
+ProjectileSystem::ProjectileSystem(std::size_t cap)
+    : posX(cap), posY(cap), velX(cap), velY(cap)
+    , count(0)
+    , capacity(cap)
+    , fixedTicksPerSecond(0)
+    , grid(-CULL_MARGIN, -CULL_MARGIN, FIELD_WIDTH + 2.f * CULL_MARGIN, FIELD_HEIGHT + 2.f * CULL_MARGIN, GRID_CELL)
+    , vertices(sf::Quads) {
+    std::size_t reserved = std::min(cap, WORKING_SET);
+    grid.reserve(reserved);
+    hits.reserve(reserved);
+
+    // VertexArray has no reserve; shrinking keeps the capacity
+    vertices.resize(reserved * 4);
+    vertices.clear();
+}
+
+bool ProjectileSystem::spawn(float x, float y, float vx, float vy) {
+    if (count == capacity) {
+        return false;
+    }
+
+    posX[count] = x;
+    posY[count] = y;
+    velX[count] = vx;
+    velY[count] = vy;
+    ++count;
+    return true;
+}
+
+void ProjectileSystem::update(float dt) {
+    float* px = posX.data();
+    float* py = posY.data();
+    const float* vx = velX.data();
+    const float* vy = velY.data();
+
+    // Integrate (branch-free, vectorizable)
+    for (std::size_t i = 0; i < count; ++i) {
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+    }
+
+    // Stable compaction keeps spawn order, so results are deterministic
+    const float minX = -CULL_MARGIN, maxX = FIELD_WIDTH + CULL_MARGIN;
+    const float minY = -CULL_MARGIN, maxY = FIELD_HEIGHT + CULL_MARGIN;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        bool inside = px[i] >= minX && px[i] <= maxX && py[i] >= minY && py[i] <= maxY;
+        if (inside) {
+            posX[kept] = px[i];
+            posY[kept] = py[i];
+            velX[kept] = vx[i];
+            velY[kept] = vy[i];
+            ++kept;
+        }
+    }
+    count = kept;
+
+    grid.build(posX.data(), posY.data(), count);
+}
+
+void ProjectileSystem::setFixedPoint(int ticksPerSecond) {
+    fixedTicksPerSecond = ticksPerSecond;
+    std::size_t size = ticksPerSecond > 0 ? capacity : 0;
+    fixedX.assign(size, Fixed());
+    fixedY.assign(size, Fixed());
+    fixedVX.assign(size, Fixed());
+    fixedVY.assign(size, Fixed());
+    clear();
+}
+
+bool ProjectileSystem::spawnFixed(const FixedVec2& pos, const FixedVec2& velocity) {
+    if (count == capacity) {
+        return false;
+    }
+
+    fixedX[count] = pos.x;
+    fixedY[count] = pos.y;
+    fixedVX[count] = velocity.x / fixedTicksPerSecond;
+    fixedVY[count] = velocity.y / fixedTicksPerSecond;
+    posX[count] = pos.x.toFloat();
+    posY[count] = pos.y.toFloat();
+    velX[count] = velocity.x.toFloat();
+    velY[count] = velocity.y.toFloat();
+    ++count;
+    return true;
+}
+
+void ProjectileSystem::updateFixed() {
+    // Same integration and stable cull as update(), on integers
+    const Fixed minX = -Fixed::fromFloat(CULL_MARGIN), maxX = Fixed::fromFloat(FIELD_WIDTH + CULL_MARGIN);
+    const Fixed minY = -Fixed::fromFloat(CULL_MARGIN), maxY = Fixed::fromFloat(FIELD_HEIGHT + CULL_MARGIN);
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Fixed x = fixedX[i] + fixedVX[i];
+        Fixed y = fixedY[i] + fixedVY[i];
+        if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+            fixedX[kept] = x;
+            fixedY[kept] = y;
+            fixedVX[kept] = fixedVX[i];
+            fixedVY[kept] = fixedVY[i];
+            posX[kept] = x.toFloat();
+            posY[kept] = y.toFloat();
+            velX[kept] = velX[i];
+            velY[kept] = velY[i];
+            ++kept;
+        }
+    }
+    count = kept;
+
+    grid.build(posX.data(), posY.data(), count);
+}
+
+void ProjectileSystem::findHits(const sf::FloatRect& target, const CollisionMask* mask, CollisionStats* stats,
+                                std::vector<std::uint32_t>& out) const {
+    // Projectile centers inside the target grown by half a projectile
+    const float half = SIZE / 2.f;
+    sf::FloatRect area(target.left - half, target.top - half, target.width + SIZE, target.height + SIZE);
+    const float maskLeft = std::floor(target.left);
+    const float maskTop = std::floor(target.top);
+    const int size = static_cast<int>(SIZE);
+
+    grid.query(area, [&](std::uint32_t i) {
+        if (!area.contains(posX[i], posY[i])) return;
+        if (stats) ++stats->boxOverlaps;
+
+        if (mask) {
+            // Projectile square in mask pixels
+            int x = static_cast<int>(std::floor(posX[i] - half - maskLeft));
+            int y = static_cast<int>(std::floor(posY[i] - half - maskTop));
+            if (stats) ++stats->maskTests;
+            if (!mask->overlapsRect(x, y, size, size)) {
+                if (stats) ++stats->maskRejects;
+                return;
+            }
+        }
+        out.push_back(i);
+    });
+}
+
+void ProjectileSystem::findHitsFixed(const FixedRect& target, const CollisionMask* mask, CollisionStats* stats,
+                                     std::vector<std::uint32_t>& out) const {
+    const Fixed size = Fixed::fromFloat(SIZE);
+    const Fixed half = size / 2;
+    FixedRect area{target.left - half, target.top - half, target.width + size, target.height + size};
+    const int maskLeft = target.left.floor();
+    const int maskTop = target.top.floor();
+
+    // The grid works on the float mirror; a pixel of slack keeps it a superset
+    // of the exact test whatever the float rounding
+    sf::FloatRect broad(area.left.toFloat() - 1.f, area.top.toFloat() - 1.f,
+                        area.width.toFloat() + 2.f, area.height.toFloat() + 2.f);
+
+    grid.query(broad, [&](std::uint32_t i) {
+        if (!area.contains(fixedX[i], fixedY[i])) return;
+        if (stats) ++stats->boxOverlaps;
+
+        if (mask) {
+            int x = (fixedX[i] - half).floor() - maskLeft;
+            int y = (fixedY[i] - half).floor() - maskTop;
+            if (stats) ++stats->maskTests;
+            if (!mask->overlapsRect(x, y, size.floor(), size.floor())) {
+                if (stats) ++stats->maskRejects;
+                return;
+            }
+        }
+        out.push_back(i);
+    });
+}
+
+int ProjectileSystem::collide(const sf::FloatRect& target, const CollisionMask* mask, CollisionStats* stats) {
+    hits.clear();
+    findHits(target, mask, stats, hits);
+    for (std::uint32_t i : hits) {
+        remove(i);
+    }
+    return static_cast<int>(hits.size());
+}
+
+void ProjectileSystem::remove(std::uint32_t index) {
+    // Indices stay valid for the grid until the next update culls it
+    posX[index] = REMOVED;
+    posY[index] = REMOVED;
+    velX[index] = 0.f;
+    velY[index] = 0.f;
+    if (fixedTicksPerSecond > 0) {
+        fixedX[index] = FIXED_REMOVED;
+        fixedY[index] = FIXED_REMOVED;
+        fixedVX[index] = Fixed();
+        fixedVY[index] = Fixed();
+    }
+}
+
+void ProjectileSystem::render(RenderBackend& backend) {
+    const float half = SIZE / 2.f;
+
+    // One quad per projectile, submitted as a single draw call
+    vertices.resize(count * 4);
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Vertex* quad = &vertices[i * 4];
+        float x = posX[i], y = posY[i];
+        quad[0] = sf::Vertex(sf::Vector2f(x - half, y - half), PROJECTILE_COLOR);
+        quad[1] = sf::Vertex(sf::Vector2f(x + half, y - half), PROJECTILE_COLOR);
+        quad[2] = sf::Vertex(sf::Vector2f(x + half, y + half), PROJECTILE_COLOR);
+        quad[3] = sf::Vertex(sf::Vector2f(x - half, y + half), PROJECTILE_COLOR);
+    }
+
+    if (count > 0) {
+        backend.drawQuads(&vertices[0], count * 4, nullptr);
+    }
+}
+
+void ProjectileSystem::clear() {
+    count = 0;
+    grid.build(posX.data(), posY.data(), 0);
+}
+
+std::size_t ProjectileSystem::size() const {
+    return count;
+}
+
+// BulletPattern presets
+BulletPattern BulletPattern::spread(int count, float spreadDegrees, float speed, float interval) {
+    return BulletPattern{PatternType::SPREAD, count, spreadDegrees, speed, interval, 0.f, 1, 0.f};
+}
+
+BulletPattern BulletPattern::spiral(int count, float spinDegrees, float speed, float interval) {
+    return BulletPattern{PatternType::SPIRAL, count, 0.f, speed, interval, spinDegrees, 1, 0.f};
+}
+
+BulletPattern BulletPattern::aimedBurst(int count, float spreadDegrees, float speed, float interval,
+                                        int burstLength, float burstPause) {
+    return BulletPattern{PatternType::AIMED_BURST, count, spreadDegrees, speed, interval, 0.f, burstLength, burstPause};
+}
+
+// BulletEmitter implementation
+BulletEmitter::BulletEmitter(const BulletPattern& p, float initialDelay)
+    : pattern(p), timer(initialDelay), angle(0.f), burstShot(0)
+    , fixedTimer(Fixed::fromFloat(initialDelay)) {}
+
+bool BulletEmitter::update(float dt, const sf::Vector2f& origin, const sf::Vector2f& target, ProjectileSystem& projectiles) {
+    timer -= dt;
+    if (timer > 0.f) return false;
+
+    fire(origin, target, projectiles);
+    timer += pattern.interval;
+
+    if (pattern.type == PatternType::AIMED_BURST && ++burstShot >= pattern.burstLength) {
+        burstShot = 0;
+        timer += pattern.burstPause;
+    }
+    return true;
+}
+
+void BulletEmitter::fire(const sf::Vector2f& origin, const sf::Vector2f& target, ProjectileSystem& projectiles) {
+    float baseDegrees = 90.f;   // Straight down the screen
+    float stepDegrees = 0.f;
+
+    switch (pattern.type) {
+        case PatternType::SPREAD:
+        case PatternType::AIMED_BURST:
+            if (pattern.type == PatternType::AIMED_BURST) {
+                baseDegrees = std::atan2(target.y - origin.y, target.x - origin.x) / DEG_TO_RAD;
+            }
+            if (pattern.count > 1) {
+                stepDegrees = pattern.spreadDegrees / (pattern.count - 1);
+                baseDegrees -= pattern.spreadDegrees / 2.f;
+            }
+            break;
+        case PatternType::SPIRAL:
+            baseDegrees = angle;
+            stepDegrees = 360.f / pattern.count;
+            angle = std::fmod(angle + pattern.spinDegrees, 360.f);
+            break;
+    }
+
+    for (int k = 0; k < pattern.count; ++k) {
+        float radians = (baseDegrees + stepDegrees * k) * DEG_TO_RAD;
+        projectiles.spawn(origin.x, origin.y,
+                          std::cos(radians) * pattern.speed, std::sin(radians) * pattern.speed);
+    }
+}
+
+bool BulletEmitter::updateFixed(const FixedVec2& origin, const FixedVec2& target, int ticksPerSecond,
+                                ProjectileSystem& projectiles) {
+    fixedTimer -= Fixed::fromInt(1) / ticksPerSecond;
+    if (fixedTimer > Fixed()) return false;
+
+    fireFixed(origin, target, projectiles);
+    fixedTimer += Fixed::fromFloat(pattern.interval);
+
+    if (pattern.type == PatternType::AIMED_BURST && ++burstShot >= pattern.burstLength) {
+        burstShot = 0;
+        fixedTimer += Fixed::fromFloat(pattern.burstPause);
+    }
+    return true;
+}
+
+void BulletEmitter::fireFixed(const FixedVec2& origin, const FixedVec2& target, ProjectileSystem& projectiles) {
+    // Same patterns as fire(), with angles in turns (a quarter turn is straight down)
+    Fixed base = Fixed::fromInt(1) / 4;
+    Fixed step;
+    Fixed spread = Fixed::fromFloat(pattern.spreadDegrees) / 360;
+
+    switch (pattern.type) {
+        case PatternType::SPREAD:
+        case PatternType::AIMED_BURST:
+            if (pattern.type == PatternType::AIMED_BURST) {
+                base = Fixed::atan2Turns(target.y - origin.y, target.x - origin.x);
+            }
+            if (pattern.count > 1) {
+                step = spread / (pattern.count - 1);
+                base -= spread / 2;
+            }
+            break;
+        case PatternType::SPIRAL:
+            base = fixedAngle;
+            step = Fixed::fromInt(1) / pattern.count;
+            fixedAngle += Fixed::fromFloat(pattern.spinDegrees) / 360;
+            if (fixedAngle >= Fixed::fromInt(1)) {
+                fixedAngle -= Fixed::fromInt(1);
+            }
+            break;
+    }
+
+    const Fixed speed = Fixed::fromFloat(pattern.speed);
+    for (int k = 0; k < pattern.count; ++k) {
+        Fixed turns = base + step * k;
+        projectiles.spawnFixed(origin, FixedVec2(Fixed::cosTurns(turns) * speed, Fixed::sinTurns(turns) * speed));
+    }
+}
@@ -0,0 +1,48 @@
+#include "RenderBackend.h"
+#include <cstdlib>
+
+void RenderBackend::drawSprite(const sf::Sprite& sprite) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (!texture) {
+        return;
+    }
+
+    // Same corners and texture coordinates SFML builds for a sprite
+    const sf::IntRect& rect = sprite.getTextureRect();
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    float left = static_cast<float>(rect.left);
+    float top = static_cast<float>(rect.top);
+    float right = left + rect.width;
+    float bottom = top + rect.height;
+
+    sf::Transform transform = sprite.getTransform();
+    sf::Color color = sprite.getColor();
+    sf::Vertex quad[4] = {
+        sf::Vertex(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top)),
+        sf::Vertex(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top)),
+        sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom)),
+        sf::Vertex(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom))
+    };
+    drawQuads(quad, 4, texture);
+}
+
+SfmlRenderBackend::SfmlRenderBackend() : target(nullptr) {}
+
+void SfmlRenderBackend::setTarget(sf::RenderTarget& renderTarget) {
+    target = &renderTarget;
+}
+
+void SfmlRenderBackend::drawQuads(const sf::Vertex* vertices, std::size_t vertexCount, const sf::Texture* texture) {
+    if (vertexCount > 0) {
+        target->draw(vertices, vertexCount, sf::Quads, sf::RenderStates(texture));
+    }
+}
+
+void SfmlRenderBackend::drawSprite(const sf::Sprite& sprite) {
+    target->draw(sprite);
+}
+
+const char* SfmlRenderBackend::getName() const {
+    return "sfml";
+}
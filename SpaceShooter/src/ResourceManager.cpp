@@ -1,19 +1,38 @@
 #include "ResourceManager.h"
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 ResourceManager& ResourceManager::getInstance() {
     static ResourceManager instance;
     return instance;
 }
 
+ResourceManager::~ResourceManager() {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        stopWorker = true;
+    }
+    jobCondition.notify_all();
+    
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
 sf::Texture& ResourceManager::loadTexture(const std::string& name, const std::string& filename) {
     auto it = textures.find(name);
     if (it != textures.end()) {
         return *it->second;
     }
     
+    std::vector<std::uint8_t> scratch;
+    std::size_t size = 0;
+    const std::uint8_t* bytes = readPacked(filename, scratch, size);
+    
     auto texture = std::make_unique<sf::Texture>();
-    if (!texture->loadFromFile(filename)) {
+    bool loaded = bytes ? texture->loadFromMemory(bytes, size) : texture->loadFromFile(filename);
+    if (!loaded) {
         std::cerr << "Failed to load texture: " << filename << std::endl;
     }
     
@@ -37,8 +56,19 @@ sf::Font& ResourceManager::loadFont(const std::string& name, const std::string&
         return *it->second;
     }
     
+    std::vector<std::uint8_t> scratch;
+    std::size_t size = 0;
+    const std::uint8_t* bytes = readPacked(filename, scratch, size);
+    
+    // sf::Font streams from its memory for its whole lifetime
+    if (bytes && bytes == scratch.data()) {
+        fontBuffers[name] = std::move(scratch);
+        bytes = fontBuffers[name].data();
+    }
+    
     auto font = std::make_unique<sf::Font>();
-    if (!font->loadFromFile(filename)) {
+    bool loaded = bytes ? font->loadFromMemory(bytes, size) : font->loadFromFile(filename);
+    if (!loaded) {
         std::cerr << "Failed to load font: " << filename << std::endl;
     }
     
@@ -56,10 +86,200 @@ sf::Font& ResourceManager::getFont(const std::string& name) {
     return *it->second;
 }
 
-void ResourceManager::createProceduralTextures() {
-    // Create player texture (green triangle)
+bool ResourceManager::mountPack(const std::string& path) {
+    return pack.open(path);
+}
+
+bool ResourceManager::readText(const std::string& filename, std::string& text) const {
+    std::vector<std::uint8_t> scratch;
+    std::size_t size = 0;
+    const std::uint8_t* bytes = readPacked(filename, scratch, size);
+    if (bytes) {
+        text.assign(reinterpret_cast<const char*>(bytes), size);
+        return true;
+    }
+    
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+const std::uint8_t* ResourceManager::readPacked(const std::string& filename, std::vector<std::uint8_t>& scratch,
+                                                std::size_t& size) const {
+    const AssetPackFormat::Entry* entry = pack.find(filename);
+    if (!entry) {
+        return nullptr;
+    }
+    
+    // Raw entries are decoded straight from the mapping without a copy
+    if (!pack.isCompressed(*entry)) {
+        size = entry->rawSize;
+        return pack.data(*entry);
+    }
+    
+    if (!pack.extract(*entry, scratch)) {
+        return nullptr;
+    }
+    size = scratch.size();
+    return scratch.data();
+}
+
+AssetHandle ResourceManager::loadTextureAsync(const std::string& name, const std::string& filename) {
+    auto it = textureHandles.find(name);
+    if (it != textureHandles.end()) {
+        return it->second;
+    }
+    
+    // Placeholder is visible under the final name until the upload replaces it in place
+    if (textures.find(name) == textures.end()) {
+        auto texture = std::make_unique<sf::Texture>();
+        texture->loadFromImage(createPlaceholderImage());
+        textures[name] = std::move(texture);
+    }
+    
+    return queueJob(AsyncJob::Kind::TEXTURE, name, filename);
+}
+
+AssetHandle ResourceManager::loadFontAsync(const std::string& name, const std::string& filename) {
+    auto it = fontHandles.find(name);
+    if (it != fontHandles.end()) {
+        return it->second;
+    }
+    
+    // An empty font renders nothing until the real one is swapped in
+    if (fonts.find(name) == fonts.end()) {
+        fonts[name] = std::make_unique<sf::Font>();
+    }
+    
+    return queueJob(AsyncJob::Kind::FONT, name, filename);
+}
+
+AssetHandle ResourceManager::queueJob(AsyncJob::Kind kind, const std::string& name, const std::string& filename) {
+    AssetHandle handle = assetReady.size();
+    assetReady.push_back(false);
+    (kind == AsyncJob::Kind::TEXTURE ? textureHandles : fontHandles)[name] = handle;
+    
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        pendingJobs.push_back(AsyncJob{handle, kind, name, filename, sf::Image(), nullptr, {}, false});
+    }
+    jobCondition.notify_one();
+    
+    // Start the loader thread on first use
+    if (!worker.joinable()) {
+        worker = std::thread(&ResourceManager::workerLoop, this);
+    }
+    
+    return handle;
+}
+
+void ResourceManager::workerLoop() {
+    while (true) {
+        AsyncJob job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+            jobCondition.wait(lock, [this] { return stopWorker || !pendingJobs.empty(); });
+            if (stopWorker) {
+                return;
+            }
+            job = std::move(pendingJobs.front());
+            pendingJobs.pop_front();
+        }
+        
+        // Decode only: GPU resources are created on the main thread
+        std::size_t size = 0;
+        const std::uint8_t* bytes = readPacked(job.filename, job.buffer, size);
+        
+        if (job.kind == AsyncJob::Kind::TEXTURE) {
+            job.loaded = bytes ? job.image.loadFromMemory(bytes, size) : job.image.loadFromFile(job.filename);
+            job.buffer.clear();
+        } else {
+            job.font = std::make_unique<sf::Font>();
+            job.loaded = bytes ? job.font->loadFromMemory(bytes, size) : job.font->loadFromFile(job.filename);
+        }
+        
+        std::lock_guard<std::mutex> lock(jobMutex);
+        finishedJobs.push_back(std::move(job));
+    }
+}
+
+void ResourceManager::processAsyncLoads() {
+    std::vector<AsyncJob> jobs;
     {
-        sf::Image img;
+        std::lock_guard<std::mutex> lock(jobMutex);
+        if (finishedJobs.empty()) {
+            return;
+        }
+        jobs.swap(finishedJobs);
+    }
+    
+    for (auto& job : jobs) {
+        if (!job.loaded) {
+            std::cerr << "Failed to load " 
+                      << (job.kind == AsyncJob::Kind::TEXTURE ? "texture: " : "font: ")
+                      << job.filename << std::endl;
+        } else if (job.kind == AsyncJob::Kind::TEXTURE) {
+            // Upload into the existing object so sprites keep a valid reference
+            // (their texture rects are still the placeholder's; see loadTextureAsync)
+            textures[job.name]->loadFromImage(job.image);
+        } else {
+            if (!job.buffer.empty()) {
+                fontBuffers[job.name] = std::move(job.buffer);
+            }
+            *fonts[job.name] = *job.font;
+        }
+        
+        // Failed loads keep their placeholder but still count as finished
+        assetReady[job.handle] = true;
+        ++completedCount;
+    }
+}
+
+bool ResourceManager::isReady(AssetHandle handle) const {
+    return handle < assetReady.size() && assetReady[handle];
+}
+
+float ResourceManager::getLoadingProgress() const {
+    if (assetReady.empty()) {
+        return 1.f;
+    }
+    return static_cast<float>(completedCount) / static_cast<float>(assetReady.size());
+}
+
+sf::Image ResourceManager::createPlaceholderImage() {
+    // Magenta/black checkerboard so missing uploads are obvious
+    sf::Image img;
+    img.create(16, 16, sf::Color::Black);
+    for (unsigned int y = 0; y < 16; ++y) {
+        for (unsigned int x = 0; x < 16; ++x) {
+            if (((x / 8) + (y / 8)) % 2 == 0) {
+                img.setPixel(x, y, sf::Color::Magenta);
+            }
+        }
+    }
+    return img;
+}
+
+void ResourceManager::createProceduralTextures() {
+    for (const char* name : {"player", "enemy", "bullet", "particle", "star"}) {
+        sf::Image img = createProceduralImage(name);
+        auto texture = std::make_unique<sf::Texture>();
+        texture->loadFromImage(img);
+        textures[name] = std::move(texture);
+        
+        // Opaque pixels of the same image, for pixel-accurate collisions
+        masks[name] = CollisionMask::fromImage(img);
+    }
+}
+
+sf::Image ResourceManager::createProceduralImage(const std::string& name) {
+    sf::Image img;
+    
+    if (name == "player") {
+        // Green triangle
         img.create(32, 32, sf::Color::Transparent);
         for (int y = 0; y < 32; ++y) {
             for (int x = 0; x < 32; ++x) {
@@ -69,14 +289,8 @@ void ResourceManager::createProceduralTextures() {
                 }
             }
         }
-        auto texture = std::make_unique<sf::Texture>();
-        texture->loadFromImage(img);
-        textures["player"] = std::move(texture);
-    }
-    
-    // Create enemy texture (red inverted triangle)
-    {
-        sf::Image img;
+    } else if (name == "enemy") {
+        // Red inverted triangle
         img.create(32, 32, sf::Color::Transparent);
         for (int y = 0; y < 32; ++y) {
             for (int x = 0; x < 32; ++x) {
@@ -85,35 +299,21 @@ void ResourceManager::createProceduralTextures() {
                 }
             }
         }
-        auto texture = std::make_unique<sf::Texture>();
-        texture->loadFromImage(img);
-        textures["enemy"] = std::move(texture);
-    }
-    
-    // Create bullet texture (yellow rectangle)
-    {
-        sf::Image img;
+    } else if (name == "bullet") {
+        // Yellow rectangle
         img.create(8, 16, sf::Color::Yellow);
-        auto texture = std::make_unique<sf::Texture>();
-        texture->loadFromImage(img);
-        textures["bullet"] = std::move(texture);
-    }
-    
-    // Create particle texture (white square)
-    {
-        sf::Image img;
+    } else if (name == "particle") {
+        // White square
         img.create(4, 4, sf::Color::White);
-        auto texture = std::make_unique<sf::Texture>();
-        texture->loadFromImage(img);
-        textures["particle"] = std::move(texture);
-    }
-    
-    // Create background star texture
-    {
-        sf::Image img;
+    } else if (name == "star") {
+        // Background star
         img.create(2, 2, sf::Color::White);
-        auto texture = std::make_unique<sf::Texture>();
-        texture->loadFromImage(img);
-        textures["star"] = std::move(texture);
     }
+    
+    return img;
+}
+
+const CollisionMask* ResourceManager::getMask(const std::string& name) const {
+    auto it = masks.find(name);
+    return it == masks.end() ? nullptr : &it->second;
 }
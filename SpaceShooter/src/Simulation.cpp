@@ -0,0 +1,616 @@
+#include "Simulation.h"
+#include "Profiler.h"
+#include "Playfield.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Firing patterns of armed enemies, in LevelFormat::PATTERN_NAMES order
+    const BulletPattern ENEMY_PATTERNS[LevelFormat::PATTERN_COUNT] = {
+        BulletPattern::spread(5, 60.f, 180.f, 1.6f),
+        BulletPattern::spiral(8, 15.f, 140.f, 0.35f),
+        BulletPattern::aimedBurst(3, 20.f, 240.f, 0.12f, 3, 1.5f)
+    };
+
+    // Fixed-point mode draws straight from the generator: mt19937's output is
+    // fixed by the standard, the distributions' float math is not
+    Fixed randomUnit(std::mt19937& rng) {
+        return Fixed::fromRaw(static_cast<std::int32_t>(rng() >> Fixed::FRACTION_BITS));
+    }
+
+    const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+    const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+    void hashWord(std::uint64_t& hash, std::uint32_t word) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (word >> (8 * i)) & 0xFFu;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    std::uint32_t floatBits(float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+Simulation::Simulation(const SimulationConfig& cfg)
+    : config(cfg) {
+    if (!config.paths.empty()) {
+        movement.setPaths(config.paths);
+    }
+
+    enemies.reserve(ENTITY_RESERVE);
+    enemyPool.reserve(ENTITY_RESERVE);
+    bullets.reserve(ENTITY_RESERVE);
+    movement.reserve(ENTITY_RESERVE);
+    enemyIndex.reserve(ENTITY_RESERVE);
+    hits.reserve(ENTITY_RESERVE);
+    projectileHits.reserve(ENTITY_RESERVE);
+    events.reserve(ENTITY_RESERVE);
+    timers.reserve(ENTITY_RESERVE);
+    if (config.fixedPoint) {
+        enemyProjectiles.setFixedPoint(TICKS_PER_SECOND);
+    }
+
+    if (!config.levelPath.empty() && level.open(config.levelPath)) {
+        for (const std::string& name : level.getPathNames()) {
+            int path = movement.findPath(name);
+            if (path < 0) {
+                std::cerr << "Unknown path in level: " << name << std::endl;
+                path = 0;
+            }
+            levelPaths.push_back(path);
+        }
+        levelSpawns.reserve(ENTITY_RESERVE);
+    }
+
+    for (std::size_t i = 0; i < ENEMY_POOL_PREFILL; ++i) {
+        enemyPool.push_back(std::make_unique<Enemy>(0.f, Playfield::ENEMY_SPAWN_Y, MovementSystem::INVALID_MOVER, config.textures.enemy));
+    }
+    reset(config.seed);
+}
+
+void Simulation::reset(std::uint32_t seed) {
+    rng.seed(seed);
+
+    // Clear all entities
+    bullets.clear();
+    enemies.clear();
+    movement.clear();
+    enemyProjectiles.clear();
+    enemyIndex.clear();
+    hits.clear();
+    events.clear();
+    timers.clear();
+
+    // Create player
+    player = std::make_unique<Player>(config.textures.player);
+    player->setPosition(Playfield::WIDTH / 2.f, Playfield::HEIGHT - 100.f);
+    if (config.fixedPoint) {
+        player->setFixedPosition(FixedVec2(Fixed::fromFloat(Playfield::WIDTH / 2.f), Fixed::fromFloat(Playfield::HEIGHT - 100.f)));
+    }
+
+    // Reset game stats
+    score = 0;
+    difficultyLevel = 1.f;
+    fixedDifficulty = Fixed::fromInt(1);
+    over = false;
+    collisionStats = CollisionStats();
+    enemiesSpawned = 0;
+
+    // First enemy after two seconds (or when the level says)
+    spawnTimer = TimingWheel::INVALID_TIMER;
+    spawnInterval = TimingWheel::toTicks(2.f, TICK);
+    lastSpawnTick = 0;
+    if (level.isOpen()) {
+        level.rewind();
+    } else {
+        scheduleSpawn();
+    }
+}
+
+void Simulation::scheduleSpawn() {
+    // Due one interval after the last spawn; if that already passed (the interval
+    // just shrank), on the next tick
+    timers.cancel(spawnTimer);
+    std::uint64_t due = lastSpawnTick + spawnInterval;
+    std::uint64_t delay = due > timers.now() ? due - timers.now() : 1;
+    spawnTimer = timers.schedule(delay, [this]() {
+        ProfileZone zone("spawn");
+        if (config.fixedPoint) {
+            spawnEnemyFixed();
+        } else {
+            spawnEnemy();
+        }
+        lastSpawnTick = timers.now();
+        scheduleSpawn();
+    });
+}
+
+void Simulation::step(const PlayerInput& input) {
+    events.clear();
+
+    // Timers due this tick fire first (weapon cooldown, enemy spawns)
+    timers.advance();
+    if (level.isOpen()) {
+        spawnFromLevel();
+    }
+
+    if (config.fixedPoint) {
+        updateEntitiesFixed(input);
+    } else {
+        updateEntities(input);
+    }
+
+    // Collisions: detection only records hits; damage, score and events are
+    // applied afterwards in queue order
+    {
+        ProfileZone zone("collisions");
+        hits.clear();
+        detectBulletHits(bullets, 0, bullets.size(), enemies, config.masks, hits, collisionStats, config.fixedPoint);
+        detectPlayerHits(hits, collisionStats);
+        resolveHits(hits);
+    }
+
+    // Cleanup inactive entities
+    cleanupEntities();
+
+    // Update difficulty based on score
+    if (config.fixedPoint) {
+        fixedDifficulty = fixedDifficultyFor(score);
+        difficultyLevel = fixedDifficulty.toFloat();
+    } else {
+        difficultyLevel = 1.f + (score / 100.f) * 0.5f;
+    }
+
+    if (level.isOpen()) {
+        if (level.isFinished() && enemies.empty()) {
+            over = true;
+        }
+        return;
+    }
+
+    // Faster spawns move the pending spawn up
+    std::uint64_t interval;
+    if (config.fixedPoint) {
+        int ticks = (Fixed::fromInt(2 * TICKS_PER_SECOND) / fixedDifficulty).round();
+        interval = static_cast<std::uint64_t>(std::max(TICKS_PER_SECOND / 2, ticks));
+    } else {
+        interval = TimingWheel::toTicks(std::max(0.5f, 2.f / difficultyLevel), TICK);
+    }
+    if (interval != spawnInterval) {
+        spawnInterval = interval;
+        scheduleSpawn();
+    }
+}
+
+Fixed Simulation::fixedDifficultyFor(int score) {
+    const std::int64_t cap = static_cast<std::int64_t>(MAX_FIXED_DIFFICULTY) * Fixed::ONE;
+    std::int64_t raw = Fixed::ONE + static_cast<std::int64_t>(std::max(score, 0)) * Fixed::ONE / 200;
+    return Fixed::fromRaw(static_cast<std::int32_t>(std::min(raw, cap)));
+}
+
+void Simulation::updateEntities(const PlayerInput& input) {
+    const float dt = TICK;
+
+    // Update player
+    player->setInput(input);
+    player->update(dt);
+
+    // Holding fire shoots whenever the cooldown allows
+    if (input.fire && player->canShoot()) {
+        sf::Vector2f pos = player->getPosition();
+        bullets.emplace_back(pos.x, pos.y - 20, config.textures.bullet);
+        events.push(GameEvent{GameEventType::PLAYER_FIRED, pos.x, pos.y, 0});
+        player->disarm();
+        timers.schedule(TimingWheel::toTicks(player->getShootCooldown(), TICK), [this]() { player->rearm(); });
+    }
+
+    if (!player->isAlive()) {
+        over = true;
+    }
+
+    // Update bullets
+    for (auto& bullet : bullets) {
+        bullet.update(dt);
+    }
+
+    // Update enemies: all movers of a path are evaluated in one batch, then copied to sprites
+    movement.update(dt);
+    for (auto& enemy : enemies) {
+        sf::Vector2f previous = enemy->getPosition();
+        sf::Vector2f pos = movement.getPosition(enemy->getMover());
+        enemy->setPosition(pos);
+        enemy->update(dt);
+        enemyIndex.update(enemy->getProxy(), pos.x - previous.x, pos.y - previous.y);
+    }
+
+    // Enemy fire (aimed patterns track the player)
+    sf::Vector2f target = player->getPosition();
+    for (auto& enemy : enemies) {
+        if (enemy->updateWeapon(dt, target, enemyProjectiles)) {
+            sf::Vector2f pos = enemy->getPosition();
+            events.push(GameEvent{GameEventType::ENEMY_FIRED, pos.x, pos.y, 0});
+        }
+    }
+    enemyProjectiles.update(dt);
+}
+
+void Simulation::updateEntitiesFixed(const PlayerInput& input) {
+    // Same order as updateEntities(); gameplay state is fixed point, sprites
+    // and the enemy index follow the float mirror
+    player->setInput(input);
+    player->updateFixed(TICKS_PER_SECOND);
+
+    if (input.fire && player->canShoot()) {
+        const FixedVec2& pos = player->getFixedPosition();
+        FixedVec2 muzzle(pos.x, pos.y - Fixed::fromInt(20));
+        bullets.emplace_back(muzzle.x.toFloat(), muzzle.y.toFloat(), config.textures.bullet);
+        bullets.back().initFixed(muzzle, TICKS_PER_SECOND);
+        events.push(GameEvent{GameEventType::PLAYER_FIRED, pos.x.toFloat(), pos.y.toFloat(), 0});
+        player->disarm();
+        int cooldown = (Fixed::fromFloat(player->getShootCooldown()) * TICKS_PER_SECOND).round();
+        timers.schedule(static_cast<std::uint64_t>(std::max(1, cooldown)), [this]() { player->rearm(); });
+    }
+
+    if (!player->isAlive()) {
+        over = true;
+    }
+
+    for (auto& bullet : bullets) {
+        bullet.updateFixed();
+    }
+
+    movement.updateFixed(TICKS_PER_SECOND);
+    for (auto& enemy : enemies) {
+        sf::Vector2f previous = enemy->getPosition();
+        enemy->updateFixed(movement.getFixedPosition(enemy->getMover()));
+        sf::Vector2f pos = enemy->getPosition();
+        enemyIndex.update(enemy->getProxy(), pos.x - previous.x, pos.y - previous.y);
+    }
+
+    const FixedVec2& target = player->getFixedPosition();
+    for (auto& enemy : enemies) {
+        if (enemy->updateWeaponFixed(target, TICKS_PER_SECOND, enemyProjectiles)) {
+            sf::Vector2f pos = enemy->getPosition();
+            events.push(GameEvent{GameEventType::ENEMY_FIRED, pos.x, pos.y, 0});
+        }
+    }
+    enemyProjectiles.updateFixed();
+}
+
+void Simulation::spawnEnemy() {
+    std::uniform_real_distribution<float> posX(Playfield::ENEMY_SPAWN_MARGIN, Playfield::WIDTH - Playfield::ENEMY_SPAWN_MARGIN);
+    std::uniform_real_distribution<float> roll(0.f, 1.f);
+    std::uniform_int_distribution<int> pickPath(0, static_cast<int>(movement.getPathCount()) - 1);
+
+    // Difficulty speeds up the whole path
+    float x = posX(rng);
+    Enemy& enemy = addEnemy(static_cast<std::size_t>(pickPath(rng)), x, Playfield::ENEMY_SPAWN_Y, difficultyLevel);
+
+    // More enemies shoot as difficulty rises
+    float armedChance = std::min(0.6f, 0.15f * difficultyLevel);
+    if (roll(rng) < armedChance) {
+        std::uniform_int_distribution<int> pick(0, LevelFormat::PATTERN_COUNT - 1);
+        enemy.arm(ENEMY_PATTERNS[pick(rng)], 0.5f + roll(rng));
+    }
+}
+
+void Simulation::spawnEnemyFixed() {
+    // spawnEnemy() with integer draws
+    const Fixed margin = Fixed::fromFloat(Playfield::ENEMY_SPAWN_MARGIN);
+    const Fixed span = Fixed::fromFloat(Playfield::WIDTH) - margin * 2;
+    Fixed x = margin + Fixed::fromRaw(static_cast<std::int32_t>(rng() % static_cast<std::uint32_t>(span.getRaw())));
+    std::size_t path = rng() % movement.getPathCount();
+    Enemy& enemy = addEnemyFixed(path, FixedVec2(x, Fixed::fromFloat(Playfield::ENEMY_SPAWN_Y)), fixedDifficulty);
+
+    Fixed armedChance = Fixed::min(Fixed::fromFloat(0.6f), Fixed::fromFloat(0.15f) * fixedDifficulty);
+    if (randomUnit(rng) < armedChance) {
+        int pattern = static_cast<int>(rng() % LevelFormat::PATTERN_COUNT);
+        enemy.arm(ENEMY_PATTERNS[pattern], (Fixed::fromFloat(0.5f) + randomUnit(rng)).toFloat());
+    }
+}
+
+void Simulation::spawnFromLevel() {
+    ProfileZone zone("spawn");
+    levelSpawns.clear();
+    level.poll(timers.now(), levelSpawns);
+
+    for (const LevelSpawn& spawn : levelSpawns) {
+        std::size_t path = static_cast<std::size_t>(levelPaths[spawn.path]);
+        float y = Playfield::ENEMY_SPAWN_Y + spawn.dy;
+        Enemy& enemy = config.fixedPoint
+            ? addEnemyFixed(path, FixedVec2(Fixed::fromFloat(spawn.x), Fixed::fromFloat(y)), Fixed::fromFloat(spawn.timeScale))
+            : addEnemy(path, spawn.x, y, spawn.timeScale);
+        if (spawn.pattern >= 0 && spawn.pattern < LevelFormat::PATTERN_COUNT) {
+            enemy.arm(ENEMY_PATTERNS[spawn.pattern], spawn.fireDelay);
+        }
+    }
+}
+
+Enemy& Simulation::addEnemy(std::size_t path, float x, float y, float timeScale) {
+    return placeEnemy(movement.add(path, x, y, timeScale), x, y);
+}
+
+Enemy& Simulation::addEnemyFixed(std::size_t path, const FixedVec2& pos, Fixed timeScale) {
+    Enemy& enemy = placeEnemy(movement.addFixed(path, pos, timeScale), pos.x.toFloat(), pos.y.toFloat());
+    enemy.setFixedPosition(pos);
+    return enemy;
+}
+
+Enemy& Simulation::placeEnemy(MoverHandle mover, float x, float y) {
+    std::unique_ptr<Enemy> enemy;
+    if (!enemyPool.empty()) {
+        enemy = std::move(enemyPool.back());
+        enemyPool.pop_back();
+        enemy->respawn(x, y, mover);
+    } else {
+        enemy = std::make_unique<Enemy>(x, y, mover, config.textures.enemy);
+    }
+
+    enemy->setProxy(enemyIndex.insert(*enemy));
+    enemies.push_back(std::move(enemy));
+    ++enemiesSpawned;
+    return *enemies.back();
+}
+
+void Simulation::detectBulletHits(const std::vector<Bullet>& bullets, std::size_t begin, std::size_t end,
+                                  const std::vector<std::unique_ptr<Enemy>>& enemies, const SpriteMasks& masks,
+                                  HitQueue& out, CollisionStats& stats, bool fixedPoint) {
+    for (std::size_t b = begin; b < end; ++b) {
+        const Bullet& bullet = bullets[b];
+        if (!bullet.isActive()) continue;
+
+        for (std::size_t e = 0; e < enemies.size(); ++e) {
+            const Enemy& enemy = *enemies[e];
+            if (!enemy.isActive()) continue;
+
+            bool hit = fixedPoint ? touchesFixed(bullet, masks.bullet, enemy, masks.enemy, stats)
+                                  : touches(bullet, masks.bullet, enemy, masks.enemy, stats);
+            if (hit) {
+                out.push(HitEvent{HitType::BULLET_ENEMY, static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(e)});
+            }
+        }
+    }
+}
+
+void Simulation::detectPlayerHits(HitQueue& out, CollisionStats& stats) {
+    // Enemy vs Player
+    for (std::size_t e = 0; e < enemies.size(); ++e) {
+        const Enemy& enemy = *enemies[e];
+        if (!enemy.isActive()) continue;
+
+        bool hit = config.fixedPoint ? touchesFixed(*player, config.masks.player, enemy, config.masks.enemy, stats)
+                                     : touches(*player, config.masks.player, enemy, config.masks.enemy, stats);
+        if (hit) {
+            out.push(HitEvent{HitType::ENEMY_PLAYER, static_cast<std::uint32_t>(e), 0});
+        }
+    }
+
+    // Enemy projectiles vs Player (broad-phase grid, then the player's mask)
+    projectileHits.clear();
+    if (config.fixedPoint) {
+        enemyProjectiles.findHitsFixed(player->getFixedBounds(), config.masks.player, &stats, projectileHits);
+    } else {
+        enemyProjectiles.findHits(player->getBounds(), config.masks.player, &stats, projectileHits);
+    }
+    for (std::uint32_t i : projectileHits) {
+        out.push(HitEvent{HitType::PROJECTILE_PLAYER, i, 0});
+    }
+}
+
+void Simulation::resolveHits(const HitQueue& hits) {
+    int projectileDamage = 0;
+
+    for (const HitEvent& hit : hits) {
+        switch (hit.type) {
+            case HitType::BULLET_ENEMY: {
+                // An enemy destroyed earlier in the queue no longer absorbs bullets
+                Enemy& enemy = *enemies[hit.second];
+                if (!enemy.isActive()) break;
+
+                bullets[hit.first].setActive(false);
+                enemy.setActive(false);
+                score += enemy.getScoreValue();
+
+                sf::Vector2f pos = enemy.getPosition();
+                events.push(GameEvent{GameEventType::ENEMY_DESTROYED, pos.x, pos.y, enemy.getScoreValue()});
+                break;
+            }
+            case HitType::ENEMY_PLAYER: {
+                Enemy& enemy = *enemies[hit.first];
+                if (!enemy.isActive()) break;
+
+                enemy.setActive(false);
+                player->takeDamage(RAM_DAMAGE);
+
+                sf::Vector2f pos = enemy.getPosition();
+                events.push(GameEvent{GameEventType::PLAYER_RAMMED, pos.x, pos.y, RAM_DAMAGE});
+                break;
+            }
+            case HitType::PROJECTILE_PLAYER:
+                enemyProjectiles.remove(hit.first);
+                projectileDamage += PROJECTILE_DAMAGE;
+                break;
+        }
+    }
+
+    // Projectile hits of a tick add up to one event
+    if (projectileDamage > 0) {
+        player->takeDamage(projectileDamage);
+
+        sf::Vector2f pos = player->getPosition();
+        events.push(GameEvent{GameEventType::PLAYER_SHOT, pos.x, pos.y, projectileDamage});
+    }
+}
+
+void Simulation::cleanupEntities() {
+    // Remove inactive bullets
+    bullets.erase(
+        std::remove_if(bullets.begin(), bullets.end(),
+            [](const Bullet& b) { return !b.isActive(); }),
+        bullets.end()
+    );
+
+    // Retire inactive enemies to the pool (and drop their movers and index entries)
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < enemies.size(); ++i) {
+        if (enemies[i]->isActive()) {
+            if (kept != i) enemies[kept] = std::move(enemies[i]);
+            ++kept;
+        } else {
+            movement.remove(enemies[i]->getMover());
+            enemyIndex.remove(enemies[i]->getProxy());
+            enemyPool.push_back(std::move(enemies[i]));
+        }
+    }
+    enemies.resize(kept);
+}
+
+bool Simulation::touches(const Entity& a, const CollisionMask* maskA, const Entity& b, const CollisionMask* maskB,
+                         CollisionStats& stats) {
+    sf::FloatRect boundsA = a.getBounds();
+    sf::FloatRect boundsB = b.getBounds();
+    if (!boundsA.intersects(boundsB)) {
+        return false;
+    }
+    ++stats.boxOverlaps;
+    if (!maskA || !maskB) {
+        return true;
+    }
+
+    // Masks are laid over the bounds, snapped to whole pixels
+    ++stats.maskTests;
+    bool hit = CollisionMask::overlaps(*maskA, static_cast<int>(std::floor(boundsA.left)), static_cast<int>(std::floor(boundsA.top)),
+                                       *maskB, static_cast<int>(std::floor(boundsB.left)), static_cast<int>(std::floor(boundsB.top)));
+    if (!hit) {
+        ++stats.maskRejects;
+    }
+    return hit;
+}
+
+bool Simulation::touchesFixed(const Entity& a, const CollisionMask* maskA, const Entity& b, const CollisionMask* maskB,
+                              CollisionStats& stats) {
+    FixedRect boundsA = a.getFixedBounds();
+    FixedRect boundsB = b.getFixedBounds();
+    if (!boundsA.intersects(boundsB)) {
+        return false;
+    }
+    ++stats.boxOverlaps;
+    if (!maskA || !maskB) {
+        return true;
+    }
+
+    ++stats.maskTests;
+    bool hit = CollisionMask::overlaps(*maskA, boundsA.left.floor(), boundsA.top.floor(),
+                                       *maskB, boundsB.left.floor(), boundsB.top.floor());
+    if (!hit) {
+        ++stats.maskRejects;
+    }
+    return hit;
+}
+
+void Simulation::render(RenderBackend& backend) {
+    // Render player
+    player->render(backend);
+
+    // Render bullets
+    for (auto& bullet : bullets) {
+        bullet.render(backend);
+    }
+
+    // Render enemies
+    for (auto& enemy : enemies) {
+        enemy->render(backend);
+    }
+
+    // Render enemy projectiles (single batched draw)
+    enemyProjectiles.render(backend);
+}
+
+bool Simulation::isOver() const {
+    return over;
+}
+
+int Simulation::getScore() const {
+    return score;
+}
+
+float Simulation::getDifficulty() const {
+    return difficultyLevel;
+}
+
+std::uint64_t Simulation::getTick() const {
+    return timers.now();
+}
+
+const CollisionStats& Simulation::getCollisionStats() const {
+    return collisionStats;
+}
+
+std::uint64_t Simulation::getEnemiesSpawned() const {
+    return enemiesSpawned;
+}
+
+std::size_t Simulation::getBulletCount() const {
+    return bullets.size();
+}
+
+std::uint64_t Simulation::getStateHash() const {
+    std::uint64_t hash = FNV_OFFSET;
+    auto hashPosition = [&](const Entity& entity) {
+        if (config.fixedPoint) {
+            const FixedVec2& pos = entity.getFixedPosition();
+            hashWord(hash, static_cast<std::uint32_t>(pos.x.getRaw()));
+            hashWord(hash, static_cast<std::uint32_t>(pos.y.getRaw()));
+        } else {
+            sf::Vector2f pos = entity.getPosition();
+            hashWord(hash, floatBits(pos.x));
+            hashWord(hash, floatBits(pos.y));
+        }
+    };
+
+    hashWord(hash, static_cast<std::uint32_t>(timers.now()));
+    hashWord(hash, static_cast<std::uint32_t>(score));
+    hashWord(hash, static_cast<std::uint32_t>(player->getHealth()));
+    hashPosition(*player);
+
+    hashWord(hash, static_cast<std::uint32_t>(bullets.size()));
+    for (const Bullet& bullet : bullets) {
+        hashPosition(bullet);
+    }
+    hashWord(hash, static_cast<std::uint32_t>(enemies.size()));
+    for (const auto& enemy : enemies) {
+        hashPosition(*enemy);
+    }
+    hashWord(hash, static_cast<std::uint32_t>(enemyProjectiles.size()));
+    enemyProjectiles.visitState([&](std::uint32_t x, std::uint32_t y) {
+        hashWord(hash, x);
+        hashWord(hash, y);
+    });
+    return hash;
+}
+
+const Player& Simulation::getPlayer() const {
+    return *player;
+}
+
+const std::vector<std::unique_ptr<Enemy>>& Simulation::getEnemies() const {
+    return enemies;
+}
+
+const ProjectileSystem& Simulation::getEnemyProjectiles() const {
+    return enemyProjectiles;
+}
+
+const SpatialIndex& Simulation::getEnemyIndex() const {
+    return enemyIndex;
+}
+
+const GameEventQueue& Simulation::getEvents() const {
+    return events;
+}
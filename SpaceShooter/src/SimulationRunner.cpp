@@ -0,0 +1,183 @@
+#include "SimulationRunner.h"
+#include "Simulation.h"
+#include "InputSource.h"
+#include "ResourceManager.h"
+#include "EngineMetrics.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+BatchResult runSimulationBatch(const BatchOptions& options, EngineMetrics* metrics) {
+    int sessions = std::max(0, options.sessions);
+    BatchResult batch;
+    batch.sessions.resize(static_cast<std::size_t>(sessions));
+    std::mutex statsMutex;
+
+    // Paths are parsed once and copied into each worker's simulation
+    SimulationConfig config;
+    MovementSystem::readPathFile(options.pathFile, config.paths);
+    config.levelPath = options.levelPath;
+    config.fixedPoint = options.fixedPoint;
+
+    // Same masks the game builds from its procedural sprites (no textures needed)
+    CollisionMask playerMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("player"));
+    CollisionMask enemyMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("enemy"));
+    CollisionMask bulletMask = CollisionMask::fromImage(ResourceManager::createProceduralImage("bullet"));
+    if (options.pixelCollisions) {
+        config.masks.player = &playerMask;
+        config.masks.enemy = &enemyMask;
+        config.masks.bullet = &bulletMask;
+    }
+
+    int threads = options.threads > 0 ? options.threads
+                                      : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, std::max(1, sessions)));
+
+    std::atomic<int> nextSession(0);
+    auto worker = [&]() {
+        // One simulation per thread, reset between sessions to reuse its buffers
+        Simulation simulation(config);
+        AutopilotInput::DecisionStats decisions;
+        CollisionStats collisions;
+        int index;
+        while ((index = nextSession.fetch_add(1)) < sessions) {
+            std::uint32_t seed = options.seed + static_cast<std::uint32_t>(index);
+            simulation.reset(seed);
+
+            // Fresh bot per session so no state leaks between sessions
+            std::unique_ptr<InputSource> input;
+            AutopilotInput* autopilot = nullptr;
+            if (options.bot == BotType::AUTOPILOT) {
+                auto bot = std::make_unique<AutopilotInput>();
+                autopilot = bot.get();
+                input = std::move(bot);
+            } else {
+                input = std::make_unique<ScriptedInput>(seed * 2654435761u);
+            }
+
+            // Destroyed enemies and damage only show in step events; tallied for metrics only
+            EventTally events;
+            while (!simulation.isOver() && simulation.getTick() < static_cast<std::uint64_t>(options.maxTicks)) {
+                simulation.step(input->nextInput(simulation));
+                if (metrics) {
+                    events.add(simulation.getEvents());
+                }
+            }
+            if (autopilot) {
+                decisions.merge(autopilot->getStats());
+            }
+            collisions.merge(simulation.getCollisionStats());
+            if (metrics) {
+                metrics->recordSession(simulation, events);
+            }
+
+            SessionResult& result = batch.sessions[static_cast<std::size_t>(index)];
+            result.seed = seed;
+            result.score = simulation.getScore();
+            result.ticks = simulation.getTick();
+            result.survived = !simulation.isOver() || simulation.getPlayer().isAlive();   // Alive at the end of a level counts
+            result.stateHash = simulation.getStateHash();
+        }
+
+        std::lock_guard<std::mutex> lock(statsMutex);
+        batch.decisions.merge(decisions);
+        batch.collisions.merge(collisions);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    batch.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return batch;
+}
+
+int runBatchReport(const BatchOptions& options) {
+    if (options.sessions <= 0 || options.maxTicks <= 0) {
+        std::cerr << "Batch needs at least one session and one tick" << std::endl;
+        return 1;
+    }
+
+    int threads = options.threads > 0 ? options.threads
+                                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::cout << "Simulation batch: " << options.sessions << " sessions, up to " << options.maxTicks
+              << " ticks each, seeds " << options.seed << "+, " << threads << " threads, "
+              << (options.bot == BotType::AUTOPILOT ? "autopilot" : "scripted") << " bot, " << (options.pixelCollisions ? "pixel" : "box") << " collisions"
+              << (options.fixedPoint ? ", fixed point" : "")
+              << (options.levelPath.empty() ? "" : ", level ") << options.levelPath << std::endl;
+
+    // Soak runs can be scraped while they go
+    std::unique_ptr<EngineMetrics> metrics;
+    std::unique_ptr<MetricsServer> metricsServer;
+    if (!options.metricsAddress.empty()) {
+        metrics = std::make_unique<EngineMetrics>();
+        metricsServer = std::make_unique<MetricsServer>(metrics->registry);
+        if (!metricsServer->start(options.metricsAddress)) {
+            return 1;
+        }
+        std::cout << "  metrics: " << metricsServer->getUrl() << std::endl;
+    }
+
+    BatchResult batch = runSimulationBatch(options, metrics.get());
+    const std::vector<SessionResult>& results = batch.sessions;
+    double seconds = batch.wallSeconds;
+
+    std::vector<int> scores;
+    std::uint64_t totalTicks = 0;
+    long long totalScore = 0;
+    int survivors = 0;
+    std::uint64_t stateHash = 0;        // Folded in session order, so independent of the thread count
+    for (const auto& result : results) {
+        stateHash = (stateHash ^ result.stateHash) * 1099511628211ull;
+        scores.push_back(result.score);
+        totalTicks += result.ticks;
+        totalScore += result.score;
+        if (result.survived) ++survivors;
+    }
+    std::sort(scores.begin(), scores.end());
+
+    double sessions = static_cast<double>(results.size());
+    std::cout << std::fixed << std::setprecision(1)
+              << "  score: mean " << totalScore / sessions
+              << ", median " << scores[scores.size() / 2]
+              << ", min " << scores.front() << ", max " << scores.back() << "\n"
+              << "  survival: mean " << totalTicks / sessions * Simulation::TICK << " s"
+              << ", " << 100.0 * survivors / sessions << "% reached the tick limit\n"
+              << "  wall " << std::setprecision(2) << seconds << " s, "
+              << std::setprecision(1) << sessions / seconds << " sims/s, "
+              << std::setprecision(0) << totalTicks / seconds << " ticks/s" << std::endl;
+    std::cout << "  state hash: " << std::hex << std::setw(16) << std::setfill('0') << stateHash
+              << std::dec << std::setfill(' ') << std::endl;
+
+    const CollisionStats& c = batch.collisions;
+    if (c.maskTests > 0) {
+        std::cout << std::setprecision(1)
+                  << "  collisions: " << c.boxOverlaps << " box overlaps, " << c.maskRejects
+                  << " rejected by masks (" << 100.0 * c.maskRejects / c.boxOverlaps << "%)" << std::endl;
+    }
+
+    if (batch.decisions.decisions > 0) {
+        const AutopilotInput::DecisionStats& d = batch.decisions;
+        std::cout << std::setprecision(2)
+                  << "  autopilot: mean " << d.meanUs() << " us/decision"
+                  << ", max " << d.maxNs / 1000.0 << " us"
+                  << ", " << std::setprecision(1) << static_cast<double>(d.threatsVisited) / d.decisions
+                  << " query candidates/decision" << std::endl;
+    }
+
+    if (metricsServer) {
+        metricsServer->stop();
+        std::cout << "  metrics: served " << metricsServer->getScrapes() << " scrapes" << std::endl;
+    }
+    return 0;
+}
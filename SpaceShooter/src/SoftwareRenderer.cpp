@@ -0,0 +1,413 @@
+#include "SoftwareRenderer.h"
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    const std::uint32_t WHITE = 0xFFFFFFFFu;
+    const std::uint32_t ALPHA_MASK = 0xFF000000u;
+    const std::int64_t TEXEL_ONE = 1 << 16;
+
+    std::uint32_t packColor(const sf::Color& color) {
+        return static_cast<std::uint32_t>(color.r) | (static_cast<std::uint32_t>(color.g) << 8)
+             | (static_cast<std::uint32_t>(color.b) << 16) | (static_cast<std::uint32_t>(color.a) << 24);
+    }
+
+    // x / 255 rounded to nearest; exact for every product of two bytes
+    inline std::uint32_t div255(std::uint32_t x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    // Texel times vertex color, per channel
+    inline std::uint32_t modulate(std::uint32_t texel, std::uint32_t color) {
+        std::uint32_t out = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            out |= div255(((texel >> shift) & 0xFF) * ((color >> shift) & 0xFF)) << shift;
+        }
+        return out;
+    }
+
+    // SFML's BlendAlpha on the color channels; the framebuffer stays opaque
+    inline std::uint32_t blend(std::uint32_t src, std::uint32_t dst) {
+        std::uint32_t a = src >> 24;
+        std::uint32_t out = ALPHA_MASK;
+        for (int shift = 0; shift < 24; shift += 8) {
+            out |= div255(((src >> shift) & 0xFF) * a + ((dst >> shift) & 0xFF) * (255 - a)) << shift;
+        }
+        return out;
+    }
+
+#if defined(__SSE2__)
+    // Eight 16-bit lanes at once, same rounding as div255()
+    inline __m128i div255x8(__m128i x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    // Each pixel's alpha lane copied over its four lanes
+    inline __m128i broadcastAlpha(__m128i x) {
+        return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF);
+    }
+
+    // modulate() (when tinted) and blend() for four pixels
+    inline void blend4(std::uint32_t* dst, __m128i src, __m128i color, bool tinted) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i full = _mm_set1_epi16(255);
+
+        __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+        __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+        if (tinted) {
+            srcLo = div255x8(_mm_mullo_epi16(srcLo, color));
+            srcHi = div255x8(_mm_mullo_epi16(srcHi, color));
+        }
+        __m128i alphaLo = broadcastAlpha(srcLo);
+        __m128i alphaHi = broadcastAlpha(srcHi);
+
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+        __m128i dstLo = _mm_unpacklo_epi8(d, zero);
+        __m128i dstHi = _mm_unpackhi_epi8(d, zero);
+
+        __m128i lo = div255x8(_mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo), _mm_mullo_epi16(dstLo, _mm_sub_epi16(full, alphaLo))));
+        __m128i hi = div255x8(_mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi), _mm_mullo_epi16(dstHi, _mm_sub_epi16(full, alphaHi))));
+        __m128i out = _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32(static_cast<int>(ALPHA_MASK)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), out);
+    }
+#endif
+}
+
+SoftwareRenderer::SoftwareRenderer(unsigned int w, unsigned int h, int threads)
+    : width(0)
+    , height(0)
+    , tilesX(0)
+    , tilesY(0)
+    , clearColor(ALPHA_MASK)
+    , viewArea(0.f, 0.f, static_cast<float>(w), static_cast<float>(h))
+    , scaleX(1.f)
+    , scaleY(1.f)
+    , offsetX(0.f)
+    , offsetY(0.f)
+    , simd(isSimdAvailable())
+    , generation(0)
+    , busyWorkers(0)
+    , stopping(false)
+    , nextTile(0) {
+    resize(w, h);
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    for (int i = 1; i < threads; ++i) {
+        workers.emplace_back(&SoftwareRenderer::workerLoop, this);
+    }
+}
+
+SoftwareRenderer::~SoftwareRenderer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void SoftwareRenderer::addTexture(const sf::Texture* texture, const sf::Image& image) {
+    TextureData data;
+    data.key = texture;
+    data.width = static_cast<int>(image.getSize().x);
+    data.height = static_cast<int>(image.getSize().y);
+    data.texels.resize(static_cast<std::size_t>(data.width) * data.height);
+    if (!data.texels.empty()) {
+        std::copy(image.getPixelsPtr(), image.getPixelsPtr() + data.texels.size() * 4,
+                  reinterpret_cast<sf::Uint8*>(data.texels.data()));
+    }
+
+    for (auto& existing : textures) {
+        if (existing.key == texture) {
+            existing = std::move(data);
+            return;
+        }
+    }
+    textures.push_back(std::move(data));
+}
+
+void SoftwareRenderer::setView(const sf::FloatRect& area) {
+    viewArea = area;
+    updateTransform();
+}
+
+void SoftwareRenderer::resize(unsigned int w, unsigned int h) {
+    width = std::max(1u, w);
+    height = std::max(1u, h);
+    tilesX = static_cast<int>((width + TILE_SIZE - 1) / TILE_SIZE);
+    tilesY = static_cast<int>((height + TILE_SIZE - 1) / TILE_SIZE);
+    pixels.assign(static_cast<std::size_t>(width) * height, clearColor);
+    tileQuads.resize(static_cast<std::size_t>(tilesX) * tilesY);
+    quads.clear();
+    updateTransform();
+}
+
+void SoftwareRenderer::updateTransform() {
+    scaleX = width / viewArea.width;
+    scaleY = height / viewArea.height;
+    offsetX = -viewArea.left * scaleX;
+    offsetY = -viewArea.top * scaleY;
+}
+
+void SoftwareRenderer::setSimd(bool enabled) {
+    simd = enabled && isSimdAvailable();
+}
+
+bool SoftwareRenderer::isSimdAvailable() const {
+#if defined(__SSE2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SoftwareRenderer::clear(const sf::Color& color) {
+    clearColor = packColor(color) | ALPHA_MASK;
+    quads.clear();
+}
+
+void SoftwareRenderer::drawQuads(const sf::Vertex* vertices, std::size_t vertexCount, const sf::Texture* texture) {
+    int textureIndex = -1;
+    if (texture) {
+        for (std::size_t i = 0; i < textures.size(); ++i) {
+            if (textures[i].key == texture) {
+                textureIndex = static_cast<int>(i);
+                break;
+            }
+        }
+        if (textureIndex < 0) return;
+    }
+
+    for (std::size_t i = 0; i + 3 < vertexCount; i += 4) {
+        const sf::Vertex& a = vertices[i];
+        const sf::Vertex& c = vertices[i + 2];
+
+        // Corners in framebuffer pixels; texture coordinates follow them when flipped
+        float x0 = a.position.x * scaleX + offsetX, x1 = c.position.x * scaleX + offsetX;
+        float y0 = a.position.y * scaleY + offsetY, y1 = c.position.y * scaleY + offsetY;
+        float u0 = a.texCoords.x, u1 = c.texCoords.x;
+        float v0 = a.texCoords.y, v1 = c.texCoords.y;
+        if (x1 < x0) {
+            std::swap(x0, x1);
+            std::swap(u0, u1);
+        }
+        if (y1 < y0) {
+            std::swap(y0, y1);
+            std::swap(v0, v1);
+        }
+
+        // Pixels whose centers are inside
+        Quad quad;
+        quad.left = std::max(0, static_cast<int>(std::ceil(x0 - 0.5f)));
+        quad.right = std::min(static_cast<int>(width), static_cast<int>(std::ceil(x1 - 0.5f)));
+        quad.top = std::max(0, static_cast<int>(std::ceil(y0 - 0.5f)));
+        quad.bottom = std::min(static_cast<int>(height), static_cast<int>(std::ceil(y1 - 0.5f)));
+        if (quad.left >= quad.right || quad.top >= quad.bottom) continue;
+
+        quad.du = (u1 - u0) / (x1 - x0);
+        quad.dv = (v1 - v0) / (y1 - y0);
+        quad.u0 = u0 + (0.5f - x0) * quad.du;
+        quad.v0 = v0 + (0.5f - y0) * quad.dv;
+        quad.color = packColor(a.color);
+        quad.texture = textureIndex;
+        quads.push_back(quad);
+
+        ++stats.quads;
+        stats.pixels += static_cast<std::uint64_t>(quad.right - quad.left) * (quad.bottom - quad.top);
+    }
+}
+
+const char* SoftwareRenderer::getName() const {
+    return "software";
+}
+
+void SoftwareRenderer::finish() {
+    // Bin every quad into the tiles it touches, keeping submission order per tile
+    for (auto& list : tileQuads) {
+        list.clear();
+    }
+    for (std::size_t i = 0; i < quads.size(); ++i) {
+        const Quad& quad = quads[i];
+        for (int ty = quad.top / TILE_SIZE; ty <= (quad.bottom - 1) / TILE_SIZE; ++ty) {
+            for (int tx = quad.left / TILE_SIZE; tx <= (quad.right - 1) / TILE_SIZE; ++tx) {
+                tileQuads[static_cast<std::size_t>(ty) * tilesX + tx].push_back(static_cast<std::uint32_t>(i));
+                ++stats.tileQuads;
+            }
+        }
+    }
+
+    nextTile.store(0);
+    if (!workers.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++generation;
+            busyWorkers = static_cast<int>(workers.size());
+        }
+        wake.notify_all();
+    }
+
+    // The calling thread takes tiles too
+    rasterizeTiles();
+
+    if (!workers.empty()) {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return busyWorkers == 0; });
+    }
+
+    quads.clear();
+    ++stats.frames;
+}
+
+void SoftwareRenderer::workerLoop() {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        rasterizeTiles();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void SoftwareRenderer::rasterizeTiles() {
+    const int tileCount = tilesX * tilesY;
+    int tile;
+    while ((tile = nextTile.fetch_add(1)) < tileCount) {
+        rasterizeTile(tile);
+    }
+}
+
+void SoftwareRenderer::rasterizeTile(int tile) {
+    const int x0 = (tile % tilesX) * TILE_SIZE;
+    const int y0 = (tile / tilesX) * TILE_SIZE;
+    const int x1 = std::min(x0 + TILE_SIZE, static_cast<int>(width));
+    const int y1 = std::min(y0 + TILE_SIZE, static_cast<int>(height));
+
+    for (int y = y0; y < y1; ++y) {
+        std::uint32_t* row = &pixels[static_cast<std::size_t>(y) * width];
+        std::fill(row + x0, row + x1, clearColor);
+    }
+
+    for (std::uint32_t index : tileQuads[static_cast<std::size_t>(tile)]) {
+        const Quad& quad = quads[index];
+        const int left = std::max(quad.left, x0), right = std::min(quad.right, x1);
+        const int top = std::max(quad.top, y0), bottom = std::min(quad.bottom, y1);
+        const TextureData* texture = quad.texture >= 0 ? &textures[static_cast<std::size_t>(quad.texture)] : nullptr;
+
+        for (int y = top; y < bottom; ++y) {
+            const std::uint32_t* texRow = nullptr;
+            int texWidth = 0;
+            if (texture) {
+                int texY = static_cast<int>(quad.v0 + static_cast<float>(y) * quad.dv);
+                texY = std::min(std::max(texY, 0), texture->height - 1);
+                texRow = &texture->texels[static_cast<std::size_t>(texY) * texture->width];
+                texWidth = texture->width;
+            }
+            blendSpan(&pixels[static_cast<std::size_t>(y) * width + left], right - left, quad, left, texRow, texWidth);
+        }
+    }
+}
+
+void SoftwareRenderer::blendSpan(std::uint32_t* dst, int count, const Quad& quad, int firstPixel,
+                                 const std::uint32_t* texRow, int texWidth) const {
+    const bool tinted = texRow && quad.color != WHITE;
+
+    // Texel columns in 16.16 fixed point, so both paths pick the same texels
+    // and unscaled spans are exactly consecutive
+    const std::int64_t u = std::lround((quad.u0 + static_cast<float>(firstPixel) * quad.du) * TEXEL_ONE);
+    const std::int64_t du = std::lround(quad.du * TEXEL_ONE);
+
+    // Nearest texel of pixel i, or the flat color of an untextured quad
+    auto source = [&](int i) {
+        if (!texRow) return quad.color;
+        int texX = static_cast<int>((u + i * du) >> 16);
+        return texRow[std::min(std::max(texX, 0), texWidth - 1)];
+    };
+
+    int i = 0;
+#if defined(__SSE2__)
+    if (simd) {
+        const __m128i color = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(quad.color)), _mm_setzero_si128());
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(ALPHA_MASK));
+        alignas(16) std::uint32_t src[4];
+        for (; i + 4 <= count; i += 4) {
+            __m128i s;
+            int texX = texRow ? static_cast<int>((u + i * du) >> 16) : 0;
+            if (texRow && du == TEXEL_ONE && texX >= 0 && texX + 4 <= texWidth) {
+                s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(texRow + texX));
+            } else {
+                for (int k = 0; k < 4; ++k) {
+                    src[k] = source(i + k);
+                }
+                s = _mm_load_si128(reinterpret_cast<const __m128i*>(src));
+            }
+
+            // Fully transparent texels (sprite corners) leave the destination as it is
+            __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), _mm_setzero_si128());
+            if (_mm_movemask_epi8(transparent) == 0xFFFF) continue;
+
+            blend4(dst + i, s, color, tinted);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        std::uint32_t src = source(i);
+        if ((src & ALPHA_MASK) == 0) continue;
+        if (tinted) src = modulate(src, quad.color);
+        dst[i] = blend(src, dst[i]);
+    }
+}
+
+unsigned int SoftwareRenderer::getWidth() const {
+    return width;
+}
+
+unsigned int SoftwareRenderer::getHeight() const {
+    return height;
+}
+
+int SoftwareRenderer::getThreadCount() const {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+const sf::Uint8* SoftwareRenderer::getPixels() const {
+    return reinterpret_cast<const sf::Uint8*>(pixels.data());
+}
+
+sf::Image SoftwareRenderer::toImage() const {
+    sf::Image image;
+    image.create(width, height, getPixels());
+    return image;
+}
+
+std::uint64_t SoftwareRenderer::checksum() const {
+    std::uint64_t hash = 14695981039346656037ull;
+    const sf::Uint8* bytes = getPixels();
+    for (std::size_t i = 0; i < pixels.size() * 4; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const SoftwareRenderer::Stats& SoftwareRenderer::getStats() const {
+    return stats;
+}
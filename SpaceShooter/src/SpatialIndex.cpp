@@ -0,0 +1,83 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+
+SpatialIndex::SpatialIndex(float margin)
+    : tree(margin) {}
+
+SpatialIndex::Proxy SpatialIndex::insert(const Entity& entity) {
+    Proxy proxy = tree.createProxy(Aabb::fromRect(entity.getBounds()));
+    if (static_cast<std::size_t>(proxy) >= owners.size()) {
+        owners.resize(static_cast<std::size_t>(proxy) + 1, nullptr);
+    }
+    owners[proxy] = &entity;
+    return proxy;
+}
+
+void SpatialIndex::remove(Proxy proxy) {
+    tree.destroyProxy(proxy);
+    owners[proxy] = nullptr;
+}
+
+bool SpatialIndex::update(Proxy proxy, float dx, float dy) {
+    return tree.moveProxy(proxy, Aabb::fromRect(owners[proxy]->getBounds()), dx, dy);
+}
+
+void SpatialIndex::clear() {
+    tree.clear();
+    owners.clear();
+}
+
+void SpatialIndex::reserve(std::size_t entities) {
+    tree.reserve(static_cast<int>(entities));
+    owners.reserve(entities);
+}
+
+std::size_t SpatialIndex::size() const {
+    return static_cast<std::size_t>(tree.getProxyCount());
+}
+
+int SpatialIndex::getTreeHeight() const {
+    return tree.getHeight();
+}
+
+std::size_t SpatialIndex::raycastAll(const sf::Vector2f& from, const sf::Vector2f& to,
+                                     std::vector<RayHit>& hits) const {
+    hits.clear();
+    tree.raycast(from.x, from.y, to.x, to.y, [&](int proxy, float maxFraction) {
+        const Entity* entity = owners[proxy];
+        float fraction;
+        if (segmentHitsBounds(from, to, entity->getBounds(), fraction)) {
+            hits.push_back(RayHit{entity, fraction});
+        }
+        return maxFraction;
+    });
+
+    std::sort(hits.begin(), hits.end(),
+              [](const RayHit& a, const RayHit& b) { return a.fraction < b.fraction; });
+    return hits.size();
+}
+
+bool SpatialIndex::segmentHitsBounds(const sf::Vector2f& from, const sf::Vector2f& to,
+                                     const sf::FloatRect& rect, float& fraction) {
+    float enter = 0.f;
+    float exit = 1.f;
+    const float origin[2] = {from.x, from.y};
+    const float delta[2] = {to.x - from.x, to.y - from.y};
+    const float lo[2] = {rect.left, rect.top};
+    const float hi[2] = {rect.left + rect.width, rect.top + rect.height};
+
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.f) {
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        float t1 = (lo[axis] - origin[axis]) / delta[axis];
+        float t2 = (hi[axis] - origin[axis]) / delta[axis];
+        enter = std::max(enter, std::min(t1, t2));
+        exit = std::min(exit, std::max(t1, t2));
+        if (enter > exit) return false;
+    }
+
+    fraction = enter;
+    return true;
+}
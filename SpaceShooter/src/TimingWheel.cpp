@@ -0,0 +1,193 @@
+#include "TimingWheel.h"
+#include <algorithm>
+#include <cmath>
+
+TimingWheel::TimingWheel()
+    : freeList(NO_LIST)
+    , current(0)
+    , pending(0) {
+    std::fill(heads, heads + FIRING + 1, NO_LIST);
+    std::fill(tails, tails + FIRING + 1, NO_LIST);
+}
+
+TimingWheel::TimerId TimingWheel::schedule(std::uint64_t delay, Callback callback) {
+    int node = allocateNode();
+    nodes[node].expires = current + std::max<std::uint64_t>(delay, 1);
+    nodes[node].callback = std::move(callback);
+    place(node, current + 1);
+    ++pending;
+    return (static_cast<TimerId>(nodes[node].generation) << 32) | static_cast<TimerId>(node);
+}
+
+bool TimingWheel::cancel(TimerId id) {
+    int node = find(id);
+    if (node == NO_LIST) {
+        return false;
+    }
+    unlink(node);
+    releaseNode(node);
+    --pending;
+    return true;
+}
+
+bool TimingWheel::isPending(TimerId id) const {
+    return find(id) != NO_LIST;
+}
+
+void TimingWheel::advance() {
+    std::uint64_t tick = current + 1;
+
+    // Entering a new lap of a ring brings the next slot of the ring above down
+    int index = static_cast<int>(tick & (SLOTS - 1));
+    for (int level = 1; level < LEVELS && index == 0; ++level) {
+        index = static_cast<int>((tick >> (level * SLOT_BITS)) & (SLOTS - 1));
+        cascade(level, index, tick);
+    }
+    current = tick;
+
+    // Everything in this slot is due now. Move it aside first: callbacks may
+    // schedule into the slot again (for a full lap later) or cancel pending timers.
+    int slot = static_cast<int>(tick & (SLOTS - 1));
+    heads[FIRING] = heads[slot];
+    tails[FIRING] = tails[slot];
+    heads[slot] = tails[slot] = NO_LIST;
+    for (int node = heads[FIRING]; node != NO_LIST; node = nodes[node].next) {
+        nodes[node].list = FIRING;
+    }
+
+    while (heads[FIRING] != NO_LIST) {
+        int node = heads[FIRING];
+        unlink(node);
+        Callback callback = std::move(nodes[node].callback);
+        releaseNode(node);
+        --pending;
+        callback();
+    }
+}
+
+std::uint64_t TimingWheel::now() const {
+    return current;
+}
+
+std::size_t TimingWheel::size() const {
+    return pending;
+}
+
+void TimingWheel::clear() {
+    // Nodes are released rather than dropped so ids handed out before stay stale
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].list != NO_LIST) {
+            releaseNode(static_cast<int>(i));
+        }
+    }
+    std::fill(heads, heads + FIRING + 1, NO_LIST);
+    std::fill(tails, tails + FIRING + 1, NO_LIST);
+    current = 0;
+    pending = 0;
+}
+
+void TimingWheel::reserve(std::size_t timers) {
+    nodes.reserve(timers);
+}
+
+std::uint64_t TimingWheel::toTicks(float seconds, float tickLength) {
+    return static_cast<std::uint64_t>(std::max(1L, std::lround(seconds / tickLength)));
+}
+
+int TimingWheel::allocateNode() {
+    if (freeList == NO_LIST) {
+        Node node;
+        node.expires = 0;
+        node.generation = 1;
+        node.list = NO_LIST;
+        node.prev = NO_LIST;
+        node.next = NO_LIST;
+        nodes.push_back(std::move(node));
+        freeList = static_cast<int>(nodes.size()) - 1;
+    }
+
+    int node = freeList;
+    freeList = nodes[node].next;
+    nodes[node].next = NO_LIST;
+    return node;
+}
+
+void TimingWheel::releaseNode(int node) {
+    Node& n = nodes[node];
+    n.callback = nullptr;
+    n.list = NO_LIST;
+    n.generation = n.generation + 1 == 0 ? 1 : n.generation + 1;
+    n.prev = NO_LIST;
+    n.next = freeList;
+    freeList = node;
+}
+
+void TimingWheel::link(int node, int list) {
+    Node& n = nodes[node];
+    n.list = list;
+    n.prev = tails[list];
+    n.next = NO_LIST;
+    if (tails[list] != NO_LIST) {
+        nodes[tails[list]].next = node;
+    } else {
+        heads[list] = node;
+    }
+    tails[list] = node;
+}
+
+void TimingWheel::unlink(int node) {
+    Node& n = nodes[node];
+    if (n.prev != NO_LIST) {
+        nodes[n.prev].next = n.next;
+    } else {
+        heads[n.list] = n.next;
+    }
+    if (n.next != NO_LIST) {
+        nodes[n.next].prev = n.prev;
+    } else {
+        tails[n.list] = n.prev;
+    }
+    n.prev = n.next = NO_LIST;
+}
+
+void TimingWheel::place(int node, std::uint64_t base) {
+    std::uint64_t expires = nodes[node].expires;
+    std::uint64_t delta = expires - base;
+
+    // Lowest ring whose span covers the delay; the slot comes from the expiry
+    // tick's digits, so a timer reaches ring 0 exactly on its last lap
+    for (int level = 0; level < LEVELS; ++level) {
+        int shift = level * SLOT_BITS;
+        if (delta < (std::uint64_t(1) << (shift + SLOT_BITS)) || level == LEVELS - 1) {
+            if (level == LEVELS - 1 && delta >= (std::uint64_t(1) << (shift + SLOT_BITS))) {
+                // Beyond the wheel: park in the farthest slot and re-place when it cascades
+                expires = base + (std::uint64_t(1) << (shift + SLOT_BITS)) - 1;
+            }
+            int slot = static_cast<int>((expires >> shift) & (SLOTS - 1));
+            link(node, level * SLOTS + slot);
+            return;
+        }
+    }
+}
+
+void TimingWheel::cascade(int level, int index, std::uint64_t base) {
+    int list = level * SLOTS + index;
+    int node = heads[list];
+    heads[list] = tails[list] = NO_LIST;
+
+    while (node != NO_LIST) {
+        int next = nodes[node].next;
+        nodes[node].prev = nodes[node].next = NO_LIST;
+        place(node, base);
+        node = next;
+    }
+}
+
+int TimingWheel::find(TimerId id) const {
+    std::size_t node = static_cast<std::size_t>(id & 0xFFFFFFFFu);
+    std::uint32_t generation = static_cast<std::uint32_t>(id >> 32);
+    if (node >= nodes.size() || nodes[node].generation != generation || nodes[node].list == NO_LIST) {
+        return NO_LIST;
+    }
+    return static_cast<int>(node);
+}
@@ -0,0 +1,54 @@
+#include "UniformGrid.h"
+#include <algorithm>
+#include <cmath>
+
+UniformGrid::UniformGrid(float x, float y, float width, float height, float cellSize)
+    : originX(x)
+    , originY(y)
+    , invCellSize(1.f / cellSize)
+    , cols(std::max(1, static_cast<int>(std::ceil(width / cellSize))))
+    , rows(std::max(1, static_cast<int>(std::ceil(height / cellSize))))
+    , cellStart(static_cast<std::size_t>(cols * rows + 1), 0) {}
+
+void UniformGrid::reserve(std::size_t count) {
+    items.reserve(count);
+    itemCell.reserve(count);
+}
+
+int UniformGrid::cellX(float x) const {
+    int c = static_cast<int>((x - originX) * invCellSize);
+    return std::min(std::max(c, 0), cols - 1);
+}
+
+int UniformGrid::cellY(float y) const {
+    int c = static_cast<int>((y - originY) * invCellSize);
+    return std::min(std::max(c, 0), rows - 1);
+}
+
+void UniformGrid::build(const float* xs, const float* ys, std::size_t count) {
+    itemCell.resize(count);
+    items.resize(count);
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    // Pass 1: cell of each item and per-cell counts (shifted by one for the prefix sum)
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t cell = static_cast<std::uint32_t>(cellY(ys[i]) * cols + cellX(xs[i]));
+        itemCell[i] = cell;
+        ++cellStart[cell + 1];
+    }
+
+    for (std::size_t c = 1; c < cellStart.size(); ++c) {
+        cellStart[c] += cellStart[c - 1];
+    }
+
+    // Pass 2: scatter, using each cell's start as its write cursor
+    for (std::size_t i = 0; i < count; ++i) {
+        items[cellStart[itemCell[i]]++] = static_cast<std::uint32_t>(i);
+    }
+
+    // Cursors now hold each cell's end, i.e. the next cell's start: shift back
+    for (std::size_t c = cellStart.size() - 1; c > 0; --c) {
+        cellStart[c] = cellStart[c - 1];
+    }
+    cellStart[0] = 0;
+}
@@ -1,15 +1,151 @@
 #include "Game.h"
+#include "Benchmarks.h"
+#include "SimulationRunner.h"
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <string>
 
-int main() {
+int main(int argc, char* argv[]) {
+    GameOptions options;
+    BatchOptions batch;
+    bool runBatch = false;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--latency") {
+            options.measureLatency = true;
+        } else if (arg == "--legacy-input") {
+            options.legacyInput = true;
+        } else if (arg == "--bench-bullets") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runProjectileBenchmark(count > 0 ? count : 50000, 1200);
+        } else if (arg == "--bench-movement") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runMovementBenchmark(count > 0 ? count : 5000, 1200);
+        } else if (arg == "--bench-spatial") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runSpatialBenchmark(count > 0 ? count : 10000, 120);
+        } else if (arg == "--bench-masks") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runMaskBenchmark(count > 0 ? count : 1000000);
+        } else if (arg == "--bench-collisions") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runCollisionBenchmark(count > 0 ? count : 2000, 20);
+        } else if (arg == "--bench-timers") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runTimerBenchmark(count > 0 ? count : 10000, 7200);
+        } else if (arg == "--bench-audio") {
+            int rate = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runAudioBenchmark(rate > 0 ? rate : 300);
+        } else if (arg == "--bench-level") {
+            int minutes = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runLevelBenchmark(minutes > 0 ? minutes : 60);
+        } else if (arg == "--bench-render") {
+            int count = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runRenderBenchmark(count > 0 ? count : 3000, 240);
+        } else if (arg == "--bench-fixed") {
+            int sessions = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runFixedPointBenchmark(sessions > 0 ? sessions : 200);
+        } else if (arg == "--bench-metrics") {
+            int sessions = (i + 1 < argc) ? std::atoi(argv[i + 1]) : 0;
+            return runMetricsBenchmark(sessions > 0 ? sessions : 100);
+        } else if (arg == "--batch" && i + 1 < argc) {
+            runBatch = true;
+            batch.sessions = std::atoi(argv[++i]);
+        } else if (arg == "--ticks" && i + 1 < argc) {
+            batch.maxTicks = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            batch.seed = static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            batch.threads = std::atoi(argv[++i]);
+        } else if (arg == "--alloc-track") {
+            options.trackAllocations = true;
+        } else if (arg == "--alloc-test") {
+            bool hasBudget = i + 1 < argc && argv[i + 1][0] != '-';
+            options.allocationBudget = hasBudget ? std::atoi(argv[++i]) : 0;
+        } else if (arg == "--render-scale" && i + 1 < argc) {
+            options.renderScale = static_cast<float>(std::atof(argv[++i]));
+        } else if (arg == "--window" && i + 1 < argc) {
+            unsigned int width = 0, height = 0;
+            if (std::sscanf(argv[++i], "%ux%u", &width, &height) == 2 && width > 0 && height > 0) {
+                options.windowWidth = width;
+                options.windowHeight = height;
+            }
+        } else if (arg == "--capture" && i + 1 < argc) {
+            options.capturePath = argv[++i];
+            options.captureFormat = CaptureFormat::PNG;
+        } else if (arg == "--capture-raw" && i + 1 < argc) {
+            options.capturePath = argv[++i];
+            options.captureFormat = CaptureFormat::RAW;
+        } else if (arg == "--capture-pipe" && i + 1 < argc) {
+            options.capturePath = argv[++i];
+            options.captureFormat = CaptureFormat::PIPE;
+        } else if (arg == "--level" && i + 1 < argc) {
+            options.levelPath = argv[++i];
+            batch.levelPath = options.levelPath;
+        } else if (arg == "--no-idle") {
+            options.idleRendering = false;
+        } else if (arg == "--cpu-report") {
+            options.reportCpu = true;
+        } else if (arg == "--governor-log") {
+            options.logGovernor = true;
+        } else if (arg == "--audio" && i + 1 < argc) {
+            std::string output = argv[++i];
+            if (output == "null") {
+                options.audioOutput = AudioOutput::OFFLINE;
+            } else if (output == "off") {
+                options.audioOutput = AudioOutput::OFF;
+            } else {
+                options.audioOutput = AudioOutput::DEVICE;
+            }
+        } else if (arg == "--metrics" && i + 1 < argc) {
+            options.metricsAddress = argv[++i];
+            batch.metricsAddress = options.metricsAddress;
+        } else if (arg == "--software-render") {
+            options.softwareRender = true;
+        } else if (arg == "--fixed-point") {
+            options.fixedPoint = true;
+            batch.fixedPoint = true;
+        } else if (arg == "--aabb-only") {
+            batch.pixelCollisions = false;
+        } else if (arg == "--autopilot") {
+            options.autopilot = true;
+            batch.bot = BotType::AUTOPILOT;
+        } else {
+            std::cerr << "Usage: SpaceShooter [--latency] [--legacy-input] [--autopilot] [--alloc-track]\n"
+                      << "                    [--window WxH] [--render-scale S] [--level FILE]\n"
+                      << "                    [--capture DIR | --capture-raw DIR | --capture-pipe CMD]\n"
+                      << "                    [--no-idle] [--cpu-report] [--governor-log] [--audio device|null|off]\n"
+                      << "                    [--fixed-point] [--software-render] [--metrics PORT|SOCKET]\n"
+                      << "       SpaceShooter --alloc-test [budget]\n"
+                      << "       SpaceShooter --bench-bullets [count]\n"
+                      << "       SpaceShooter --bench-movement [count]\n"
+                      << "       SpaceShooter --bench-spatial [count]\n"
+                      << "       SpaceShooter --bench-collisions [count]\n"
+                      << "       SpaceShooter --bench-timers [count]\n"
+                      << "       SpaceShooter --bench-masks [pairs]\n"
+                      << "       SpaceShooter --bench-level [minutes]\n"
+                      << "       SpaceShooter --bench-audio [triggers/s]\n"
+                      << "       SpaceShooter --bench-fixed [sessions]\n"
+                      << "       SpaceShooter --bench-render [sprites]\n"
+                      << "       SpaceShooter --bench-metrics [sessions]\n"
+                      << "       SpaceShooter --batch sessions [--ticks T] [--seed S] [--threads N] [--autopilot] [--aabb-only] [--level FILE] [--fixed-point]\n"
+                      << "                         [--metrics PORT|SOCKET]" << std::endl;
+            return 1;
+        }
+    }
+    
+    if (runBatch) {
+        return runBatchReport(batch);
+    }
+    
     try {
-        Game game;
-        game.run();
+        Game game(options);
+        return game.run();
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
     }
-    
-    return 0;
 }
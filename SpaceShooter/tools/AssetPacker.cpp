@@ -0,0 +1,50 @@
+#include "AssetPack.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Usage: assetpacker [-c] [-a alignment] output.pak [name=]file...
+// Entries are looked up by name; without "name=" the file path is used as the name.
+int main(int argc, char* argv[]) {
+    bool compress = false;
+    std::uint32_t alignment = AssetPackFormat::DEFAULT_ALIGNMENT;
+    int arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-'; ++arg) {
+        std::string flag = argv[arg];
+        if (flag == "-c") {
+            compress = true;
+        } else if (flag == "-a" && arg + 1 < argc) {
+            alignment = static_cast<std::uint32_t>(std::strtoul(argv[++arg], nullptr, 10));
+        } else {
+            std::cerr << "Unknown option: " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    if (arg >= argc) {
+        std::cerr << "Usage: assetpacker [-c] [-a alignment] output.pak [name=]file..." << std::endl;
+        return 1;
+    }
+
+    std::string output = argv[arg++];
+    AssetPackWriter writer(alignment);
+
+    for (; arg < argc; ++arg) {
+        std::string spec = argv[arg];
+        std::string::size_type eq = spec.find('=');
+        std::string name = eq == std::string::npos ? spec : spec.substr(0, eq);
+        std::string file = eq == std::string::npos ? spec : spec.substr(eq + 1);
+
+        if (!writer.addFile(name, file, compress)) {
+            return 1;
+        }
+    }
+
+    if (!writer.write(output)) {
+        return 1;
+    }
+
+    std::cout << "Wrote " << output << std::endl;
+    return 0;
+}
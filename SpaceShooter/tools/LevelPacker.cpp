@@ -0,0 +1,168 @@
+#include "Level.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Usage: levelpacker script.txt output.lvl
+// Script lines ('#' starts a comment, times in seconds):
+//   formation NAME dx,dy[,delay] ...
+//   spawn TIME PATH X [formation=NAME] [pattern=spread|spiral|burst] [fire=S] [speed=X]
+//                     [repeat=N every=S step=DX]
+// Spawns may come in any order; they are sorted by time when packed.
+namespace {
+    struct Spawn {
+        std::uint64_t tick;
+        LevelFormat::SpawnRecord record;
+    };
+
+    std::uint64_t toTicks(double seconds) {
+        return static_cast<std::uint64_t>(std::llround(std::max(0.0, seconds) * LevelFormat::TICKS_PER_SECOND));
+    }
+
+    bool parseFormation(std::istringstream& in, std::vector<LevelFormat::FormationMember>& members) {
+        std::string token;
+        while (in >> token) {
+            double dx = 0.0, dy = 0.0, delay = 0.0;
+            int fields = std::sscanf(token.c_str(), "%lf,%lf,%lf", &dx, &dy, &delay);
+            if (fields < 2) return false;
+
+            LevelFormat::FormationMember member = {};
+            member.dx = static_cast<std::int16_t>(std::lround(dx));
+            member.dy = static_cast<std::int16_t>(std::lround(dy));
+            member.delayTicks = static_cast<std::uint16_t>(std::min<std::uint64_t>(toTicks(delay), 0xFFFF));
+            members.push_back(member);
+        }
+        return !members.empty();
+    }
+
+    bool parseSpawn(std::istringstream& in, LevelWriter& writer, const std::map<std::string, int>& formations,
+                    std::vector<Spawn>& spawns) {
+        double time = 0.0, x = 0.0;
+        std::string path;
+        if (!(in >> time >> path >> x)) return false;
+
+        int pathIndex = writer.addPath(path);
+        if (pathIndex < 0) return false;
+
+        LevelFormat::SpawnRecord record = {};
+        record.x = static_cast<std::int16_t>(std::lround(x));
+        record.path = static_cast<std::uint8_t>(pathIndex);
+        record.formation = LevelFormat::NO_FORMATION;
+        record.pattern = LevelFormat::NO_PATTERN;
+        record.speedTenths = 10;
+        record.fireDelayMs = 1000;
+        int repeat = 1;
+        double every = 1.0, step = 0.0;
+
+        std::string token;
+        while (in >> token) {
+            std::string::size_type eq = token.find('=');
+            if (eq == std::string::npos) return false;
+            std::string key = token.substr(0, eq);
+            std::string value = token.substr(eq + 1);
+
+            if (key == "formation") {
+                auto it = formations.find(value);
+                if (it == formations.end()) return false;
+                record.formation = static_cast<std::uint8_t>(it->second);
+            } else if (key == "pattern") {
+                int pattern = -1;
+                for (int i = 0; i < LevelFormat::PATTERN_COUNT; ++i) {
+                    if (value == LevelFormat::PATTERN_NAMES[i]) pattern = i;
+                }
+                if (pattern < 0) return false;
+                record.pattern = static_cast<std::uint8_t>(pattern);
+            } else if (key == "fire") {
+                record.fireDelayMs = static_cast<std::uint16_t>(std::min(65535.0, std::max(0.0, std::atof(value.c_str()) * 1000.0)));
+            } else if (key == "speed") {
+                record.speedTenths = static_cast<std::uint8_t>(std::min(255.0, std::max(1.0, std::round(std::atof(value.c_str()) * 10.0))));
+            } else if (key == "repeat") {
+                repeat = std::max(1, std::atoi(value.c_str()));
+            } else if (key == "every") {
+                every = std::atof(value.c_str());
+            } else if (key == "step") {
+                step = std::atof(value.c_str());
+            } else {
+                return false;
+            }
+        }
+
+        for (int i = 0; i < repeat; ++i) {
+            Spawn spawn;
+            spawn.tick = toTicks(time + i * every);
+            spawn.record = record;
+            spawn.record.x = static_cast<std::int16_t>(std::lround(x + i * step));
+            spawns.push_back(spawn);
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: levelpacker script.txt output.lvl" << std::endl;
+        return 1;
+    }
+
+    std::ifstream script(argv[1]);
+    if (!script) {
+        std::cerr << "Failed to read: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    LevelWriter writer;
+    std::map<std::string, int> formations;
+    std::vector<Spawn> spawns;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(script, line)) {
+        ++lineNumber;
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream in(line);
+        std::string directive;
+        in >> directive;
+
+        bool valid = false;
+        if (directive == "formation") {
+            std::string name;
+            std::vector<LevelFormat::FormationMember> members;
+            if (in >> name && parseFormation(in, members)) {
+                int index = writer.addFormation(members);
+                valid = index >= 0 && formations.emplace(name, index).second;
+            }
+        } else if (directive == "spawn") {
+            valid = parseSpawn(in, writer, formations, spawns);
+        }
+
+        if (!valid) {
+            std::cerr << "Invalid level script line " << lineNumber << ": " << line << std::endl;
+            return 1;
+        }
+    }
+
+    std::stable_sort(spawns.begin(), spawns.end(), [](const Spawn& a, const Spawn& b) { return a.tick < b.tick; });
+
+    bool ok = writer.begin(argv[2]);
+    for (const Spawn& spawn : spawns) {
+        ok = ok && writer.add(spawn.tick, spawn.record);
+    }
+    ok = writer.finish() && ok;
+    if (!ok) {
+        return 1;
+    }
+
+    std::cout << "Wrote " << argv[2] << " (" << spawns.size() << " spawns, "
+              << (spawns.empty() ? 0.0 : spawns.back().tick / double(LevelFormat::TICKS_PER_SECOND)) << " s)" << std::endl;
+    return 0;
+}